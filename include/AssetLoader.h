@@ -0,0 +1,69 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <SFML/Audio.hpp>
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+#include "PcmCache.h"
+
+// Decodes images and sound buffers on worker threads. The main thread polls progress (to draw
+// a loading view) and collects the results; anything touching the GPU, such as uploading the
+// atlas, stays on the main thread.
+class AssetLoader {
+public:
+    AssetLoader() = default;
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+    ~AssetLoader();
+
+    // queue before start(); the returned id is used to take the result
+    int addImage(const std::string& path);
+    int addSound(const std::string& path);
+    // decode from memory (e.g. an AssetPack blob); data must outlive the job, name is for logs
+    int addImage(std::span<const std::byte> data, const std::string& name);
+    int addSound(std::span<const std::byte> data, const std::string& name);
+
+    // sound jobs go through this cache (raw PCM instead of decoding the MP3); must outlive the run
+    void setPcmCache(const PcmCache* cache) { pcmCache_ = cache; }
+
+    // threads == 0 uses every hardware thread (capped at the job count)
+    void start(unsigned int threads = 0);
+    void wait();
+
+    size_t total() const { return jobs_.size(); }
+    size_t completed() const { return completed_.load(std::memory_order_acquire); }
+    bool done() const { return completed() == total(); }
+    unsigned int threadCount() const { return static_cast<unsigned int>(workers_.size()); }
+
+    // empty if the decode failed; only valid once the job completed (e.g. after wait())
+    std::optional<sf::Image> takeImage(int id);
+    std::optional<sf::SoundBuffer> takeSound(int id);
+    const std::string& path(int id) const { return jobs_[id]->path; }
+    // per-job instrumentation, valid once the job completed
+    bool fromCache(int id) const { return jobs_[id]->fromCache; }
+    float loadMs(int id) const { return jobs_[id]->loadMs; }
+
+private:
+    enum class Kind { Image, Sound };
+    struct Job {
+        Kind kind;
+        std::string path;
+        std::span<const std::byte> data; // empty: load from path
+        std::optional<sf::Image> image;
+        std::optional<sf::SoundBuffer> sound;
+        bool fromCache = false;
+        float loadMs = 0.f;
+    };
+
+    void workerLoop();
+
+    std::vector<std::unique_ptr<Job>> jobs_;
+    std::vector<std::thread> workers_;
+    const PcmCache* pcmCache_ = nullptr;
+    std::atomic<size_t> next_{0};
+    std::atomic<size_t> completed_{0};
+};
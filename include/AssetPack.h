@@ -0,0 +1,52 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Read-only view of a packed asset archive (built by galaga_pack), memory-mapped in one go.
+//
+// Layout, little-endian:
+//   "GPAK" | u32 version | u32 entryCount | u32 indexBytes
+//   entryCount x { u64 offset | u64 size | u32 nameLength | name bytes }
+//   blobs, each starting on a 16-byte boundary
+//
+// Names are paths relative to the assets directory with '/' separators
+// ("textures/player.png"). Views returned by find() stay valid while the pack is open, so they
+// can be handed straight to loadFromMemory / openFromMemory.
+class AssetPack {
+public:
+    AssetPack() = default;
+    AssetPack(const AssetPack&) = delete;
+    AssetPack& operator=(const AssetPack&) = delete;
+    ~AssetPack();
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return data_ != nullptr; }
+
+    // empty span when the name is not in the pack
+    std::span<const std::byte> find(std::string_view name) const;
+    size_t entryCount() const { return entries_.size(); }
+
+    // files: (name inside the pack, path on disk)
+    static bool write(const std::string& outPath, const std::vector<std::pair<std::string, std::string>>& files);
+
+private:
+    struct Entry {
+        std::string_view name;
+        std::uint64_t offset;
+        std::uint64_t size;
+    };
+
+    const std::byte* data_ = nullptr;
+    size_t size_ = 0;
+    std::vector<Entry> entries_; // sorted by name
+#ifdef _WIN32
+    void* file_ = nullptr;
+    void* mapping_ = nullptr;
+#endif
+};
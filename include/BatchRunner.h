@@ -0,0 +1,89 @@
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+#include "Simulation.h"
+
+// Per-instance state after a batch step; the vectors keep their capacity between steps.
+struct Observation {
+    SimStatus status = SimStatus::Playing;
+    int score = 0;
+    int lives = 0;
+    float playerX = 0.f;
+    int episodes = 0;                      // games finished (and auto-reset) so far
+    std::vector<std::uint64_t> aliveMask;  // bit (row * enemyCols + col) set while that enemy lives
+    std::vector<sf::Vector2f> playerBullets;
+    std::vector<sf::Vector2f> enemyBullets;
+};
+
+// Steps many independent headless Simulations in lock step on a fixed pool of worker threads.
+// Instances never share state, so workers only contend for the next chunk index; the calling
+// thread works through chunks too and step() returns once every instance has advanced.
+class BatchRunner {
+public:
+    // threads == 0 picks std::thread::hardware_concurrency(); instance i is seeded with seed + i
+    explicit BatchRunner(size_t instances, const SimConfig& config = SimConfig{},
+                         unsigned threads = 0, std::uint32_t seed = 0);
+    ~BatchRunner();
+
+    BatchRunner(const BatchRunner&) = delete;
+    BatchRunner& operator=(const BatchRunner&) = delete;
+
+    size_t size() const { return instances_.size(); }
+    unsigned threadCount() const { return static_cast<unsigned>(workers_.size()) + 1; }
+
+    // when on (default), a game that ends is reset with a fresh seed on its next step;
+    // its observation still reports the final Won/Lost state for the step it ended on
+    void setAutoReset(bool on) { autoReset_ = on; }
+
+    void reset(std::uint32_t seed);
+    void resetInstance(size_t i, std::uint32_t seed);
+
+    // inputs[i] drives instance i for all `ticks` steps of dt; inputs.size() must equal size()
+    void step(std::span<const SimInput> inputs, float dt, int ticks = 1);
+
+    const Observation& observation(size_t i) const { return instances_[i].obs; }
+    const Simulation& simulation(size_t i) const { return *instances_[i].sim; }
+    // Simulation::step calls made across all instances since construction
+    std::uint64_t totalSteps() const { return totalSteps_.load(std::memory_order_relaxed); }
+
+private:
+    // one per game; padded so neighbouring instances never share a cache line
+    struct alignas(64) Instance {
+        std::unique_ptr<Simulation> sim;
+        Observation obs;
+        std::uint32_t seed = 0;
+    };
+
+    void workerLoop();
+    void runChunks();
+    int stepInstance(Instance& in, const SimInput& input);
+    static void observe(const Simulation& sim, Observation& obs);
+
+    std::vector<Instance> instances_;
+    std::vector<std::thread> workers_;
+    bool autoReset_ = true;
+    std::atomic<std::uint64_t> totalSteps_{0};
+
+    // current job, written under mutex_ together with the generation_ bump
+    std::span<const SimInput> inputs_;
+    float dt_ = 0.f;
+    int ticks_ = 0;
+    std::atomic<size_t> nextChunk_{0};
+    std::atomic<size_t> chunksLeft_{0};
+    size_t chunkSize_ = 1;
+    size_t chunkCount_ = 0;
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    std::uint64_t generation_ = 0;
+    unsigned busy_ = 0; // workers inside runChunks(); the job may only change while this is 0
+    bool quit_ = false;
+};
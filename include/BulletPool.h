@@ -0,0 +1,42 @@
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <vector>
+#include <cstdint>
+
+// Structure-of-arrays projectile store. Spawn and retire are O(1) (free list + dense
+// active list with swap-remove) and update/collision passes only walk live bullets.
+class BulletPool {
+public:
+    explicit BulletPool(size_t capacity = 0, const sf::Vector2f& size = {15.f, 15.f});
+
+    // returns the slot id, or -1 when the pool is full
+    int spawn(const sf::Vector2f& pos, const sf::Vector2f& vel);
+    // swaps the last live bullet into the retired one's place in active()
+    void retire(int id);
+    void clear();
+    void update(float dt);
+
+    // dense list of live slot ids; retiring while iterating: don't advance the index
+    const std::vector<int>& active() const { return active_; }
+    size_t activeCount() const { return active_.size(); }
+    size_t capacity() const { return posX_.size(); }
+    bool isActive(int id) const { return denseIndex_[id] >= 0; }
+
+    sf::Vector2f position(int id) const { return { posX_[id], posY_[id] }; }
+    sf::Vector2f prevPosition(int id) const { return { prevX_[id], prevY_[id] }; }
+    sf::Vector2f velocity(int id) const { return { velX_[id], velY_[id] }; }
+    sf::FloatRect bounds(int id) const {
+        return sf::FloatRect{ { posX_[id] - halfW_[id], posY_[id] - halfH_[id] }, { halfW_[id] * 2.f, halfH_[id] * 2.f } };
+    }
+
+private:
+    std::vector<float> posX_, posY_;
+    std::vector<float> prevX_, prevY_;
+    std::vector<float> velX_, velY_;
+    std::vector<float> halfW_, halfH_;
+
+    std::vector<int> freeList_;
+    std::vector<int> active_;
+    std::vector<int> denseIndex_; // slot id -> index in active_, -1 when free
+};
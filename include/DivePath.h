@@ -0,0 +1,44 @@
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+
+// An attack path baked into an arc-length lookup table: points STEP units apart along the
+// curve, so sampling at a distance is one index plus a lerp and a diver flying at constant
+// speed really does move at that speed, however the control points are spaced.
+// Paths are offsets from where the dive starts, drawn for an enemy on the left half of the
+// field; mirrored ones swing the other way.
+class DivePath {
+public:
+    static constexpr float STEP = 2.f; // playfield units between table entries
+
+    // smooth curve through every point (centripetal Catmull-Rom)
+    static DivePath catmullRom(const std::vector<sf::Vector2f>& points);
+    // chain of cubic Béziers sharing end points: p0 c c p1 c c p2 ... (3n + 1 points)
+    static DivePath bezier(const std::vector<sf::Vector2f>& points);
+
+    // the stock dive/loop paths, baked once on first use (Simulation asks at construction)
+    static const std::vector<DivePath>& library();
+
+    // offset from the start after `distance` units along the path (clamped to its ends)
+    sf::Vector2f at(float distance, bool mirror = false) const {
+        if (lut_.empty()) return {};
+        float f = distance / STEP;
+        if (!(f > 0.f)) f = 0.f;
+        const size_t last = lut_.size() - 1;
+        size_t i = static_cast<size_t>(f);
+        sf::Vector2f p;
+        if (i >= last) p = lut_[last];
+        else p = lut_[i] + (lut_[i + 1] - lut_[i]) * (f - static_cast<float>(i));
+        if (mirror) p.x = -p.x;
+        return p;
+    }
+    float length() const { return length_; }
+    size_t tableSize() const { return lut_.size(); }
+
+private:
+    // resamples a dense polyline of the curve at equal arc-length steps
+    static DivePath bake(const std::vector<sf::Vector2f>& polyline);
+
+    std::vector<sf::Vector2f> lut_;
+    float length_ = 0.f;
+};
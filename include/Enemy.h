@@ -1,28 +1,56 @@
 #pragma once
-#include <SFML/Graphics.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <cstdint>
+
+class DivePath;
 
 class Enemy {
 public:
-    Enemy(const sf::Texture* texture = nullptr, const sf::Vector2f& startPos = {0.f,0.f});
+    enum class Motion : std::uint8_t {
+        InFormation, // sits in its slot; Formation moves it with the shared origin
+        Diving,      // flying a DivePath, then falling off the bottom of the field
+        Returning,   // re-entered above the field, homing in on its slot
+    };
+
+    // slot: centre relative to the formation origin
+    // kind: formation row type (0 top, 1 mid, 2 bottom); the front end picks the texture from it
+    Enemy(const sf::Vector2f& slot = {0.f,0.f}, const sf::Vector2f& size = {50.f, 45.f}, int kind = 0);
 
-    void update(float dt);
-    void draw(sf::RenderWindow& window) const;
+    // leaves the formation from world position `start` (its slot's current centre)
+    void startDive(const DivePath& path, const sf::Vector2f& start, bool mirror, float speed);
+    // Advances a dive by dt: one table lookup on the path, then straight down past exitY, then
+    // back in from above towards slotWorld (the slot's current world centre). Returns true on
+    // the step it reaches the slot and is back in formation.
+    bool update(float dt, const sf::Vector2f& slotWorld, float exitY);
 
     void setActive(bool v);
     bool isActive() const;
-    sf::FloatRect bounds() const;
-    void setPosition(const sf::Vector2f& pos);
 
-    sf::Vector2f getPosition() const;
-    void moveBy(const sf::Vector2f& delta);
+    sf::Vector2f slot() const { return slot_; }
+    // bounds relative to the formation origin; Formation::enemyBounds gives world space
+    sf::FloatRect localBounds() const;
+    int kind() const { return kind_; }
+
+    Motion motion() const { return motion_; }
+    bool isDiving() const { return motion_ != Motion::InFormation; }
+    // while diving: world centre now and one step earlier, and the world-space box
+    sf::Vector2f position() const { return pos_; }
+    sf::Vector2f prevPosition() const { return prevPos_; }
+    sf::FloatRect worldBounds() const { return sf::FloatRect{ pos_ - size_ / 2.f, size_ }; }
 
 private:
-    std::unique_ptr<sf::Sprite> sprite_;
-    sf::RectangleShape fallbackRect_;
+    sf::Vector2f slot_;
+    sf::Vector2f size_;
+    int kind_ = 0;
     bool active_ = true;
 
-    float speedX_ = 80.f;
-    int dir_ = 1; // 1 right, -1 left
-    float leftLimit_ = 20.f;
-    float rightLimit_ = 800.f;
-};
\ No newline at end of file
+    Motion motion_ = Motion::InFormation;
+    const DivePath* path_ = nullptr;
+    float distance_ = 0.f; // along path_
+    float speed_ = 0.f;
+    bool mirror_ = false;
+    sf::Vector2f start_;   // world centre the dive left from; path offsets are relative to it
+    sf::Vector2f pos_;
+    sf::Vector2f prevPos_;
+};
@@ -1,35 +1,78 @@
 #pragma once
-#include <SFML/Graphics.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <SFML/Graphics/Rect.hpp>
 #include <vector>
+#include <cstdint>
 #include "Enemy.h"
 
+class DivePath;
+
 class Formation {
 public:
-    Formation(const sf::Texture* topTex,
-              const sf::Texture* midTex,
-              const sf::Texture* botTex,
-              int cols, int rows,
+    // enemy kinds by row band, reported through Enemy::kind()
+    static constexpr int KIND_TOP = 0;
+    static constexpr int KIND_MID = 1;
+    static constexpr int KIND_BOTTOM = 2;
+
+    Formation(int cols, int rows,
               const sf::Vector2f& startPos,
               float spacingX, float spacingY,
+              const sf::Vector2f& enemySize = {50.f, 45.f},
               float speed = 60.f,
               float dropAmount = 16.f);
 
+    // moves the shared origin (O(1) for the whole lattice), then steps each diver on its path
     void update(float dt, float screenLeft, float screenRight);
 
-    void draw(sf::RenderWindow& window) const;
+    // world position of slot (0,0); enemy world position = origin() + enemy.slot()
+    sf::Vector2f origin() const { return origin_; }
+    // world space; a diver's own box rather than its slot's
+    sf::FloatRect enemyBounds(int index) const;
+    // world y of the lowest live row's bottom edge
+    float bottomY() const { return origin_.y + maxY_; }
+
+    // displacement applied to every live enemy by the last update (for render interpolation)
+    sf::Vector2f lastMove() const { return lastMove_; }
 
-    std::vector<Enemy>& enemies() { return enemies_; }
     const std::vector<Enemy>& enemies() const { return enemies_; }
 
+    // Swept hit test in world space: `box` is where the mover was at the start of the last update
+    // and `move` how far it went. Each test runs relative to the target's own motion over that
+    // update (the lattice's lastMove, or a diver's step). The swept box is mapped straight onto
+    // the lattice, so only the few (col,row) cells it can touch are checked against the alive
+    // mask; divers are off the lattice and checked one by one. Returns the live enemy touched
+    // first, or -1; *toi gets the time of contact in [0, 1]. cellsTested, if given, is
+    // incremented once per cell or diver looked at.
+    int sweepTest(const sf::FloatRect& box, const sf::Vector2f& move, float* toi = nullptr, int* cellsTested = nullptr) const;
+    void kill(int index);
+    bool isAlive(int index) const { return (aliveBits_[index >> 6] >> (index & 63)) & 1u; }
+    const std::vector<std::uint64_t>& aliveBits() const { return aliveBits_; }
+
+    // Dive attacks: a live enemy in its slot leaves the lattice and flies `path` (mirrored to
+    // swing right) at `speed`, then returns to its slot. It still counts as alive, and its
+    // column still shoots from it, throughout.
+    void startDive(int index, const DivePath& path, bool mirror, float speed);
+    bool isDiving(int index) const { return enemies_[index].isDiving(); }
+    const std::vector<int>& divers() const { return divers_; }
+    // divers fall past this world y before wrapping back to the top of the field
+    void setDiveExit(float y) { diveExitY_ = y; }
     void reset();
     int aliveCount() const;
 
+    // enemy fire: columns with at least one live enemy (unordered), and the index of the lowest
+    // live enemy in a column (-1 if empty). Both are kept current by kill(), so picking a
+    // shooter is one random index into liveColumns().
+    const std::vector<int>& liveColumns() const { return liveCols_; }
+    int lowestAlive(int col) const { return col >= 0 && col < cols_ && lowestRow_[col] >= 0 ? lowestRow_[col] * cols_ + col : -1; }
+
 private:
+    // tools/galaga_bench.cpp times computeBounds() directly
+    friend struct BenchAccess;
+
+    void populate();
     void computeBounds();
 
-    const sf::Texture* topTex_;
-    const sf::Texture* midTex_;
-    const sf::Texture* botTex_;
+    sf::Vector2f enemySize_;
 
     std::vector<Enemy> enemies_;
     int cols_;
@@ -42,6 +85,26 @@ private:
     float speed_;
     float dropAmount_;
 
+    // live extents relative to origin_, refreshed only when an edge column/row empties
     float minX_ = 0.f;
     float maxX_ = 0.f;
+    float maxY_ = 0.f;
+
+    sf::Vector2f origin_;
+    sf::Vector2f lastMove_{0.f, 0.f}; // displacement applied by the last update
+
+    std::vector<std::uint64_t> aliveBits_; // bit (r * cols_ + c) set while that enemy lives
+    int alive_ = 0;
+    std::vector<int> colAlive_;
+    std::vector<int> rowAlive_;
+    int firstCol_ = 0;
+    int lastCol_ = -1;
+    int lastRow_ = -1;
+
+    std::vector<int> lowestRow_;  // per column, -1 once it is empty
+    std::vector<int> liveCols_;   // dense list of non-empty columns; swap-removed
+    std::vector<int> liveColPos_; // column -> index in liveCols_, -1 when empty
+
+    std::vector<int> divers_;     // enemies off the lattice; swap-removed
+    float diveExitY_ = 1000.f;
 };
\ No newline at end of file
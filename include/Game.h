@@ -4,7 +4,18 @@
 #include <vector>
 #include <memory>
 #include <optional>
+#include <string>
 #include <random>
+#include "AssetPack.h"
+#include "HudCounter.h"
+#include "Overlay.h"
+#include "Profiler.h"
+#include "Replay.h"
+#include "SimThread.h"
+#include "SpriteBatch.h"
+#include "StaticLayer.h"
+#include "TextureAtlas.h"
+#include "VoiceManager.h"
 
 class Game {
 public:
@@ -14,7 +25,23 @@ public:
     bool init();
     void run();
 
+    // fixed simulation rate in Hz (independent of the display refresh)
+    void setSimulationRate(float hz);
+
+    // save each game's seed and per-tick input to `path` (a new game overwrites it)
+    void recordTo(const std::string& path);
+    // call before init(): play the recorded game instead of reading the keyboard; fastForward
+    // steps it as fast as the CPU allows and renders about once per 16 ms
+    bool playReplay(const std::string& path, bool fastForward);
+
+    // frame-phase timings + on-screen graph; F3 toggles, F4 writes galaga_trace.json
+    void setProfiling(bool on);
+
 private:
+    // started before the window is created, so cold-start timing covers everything
+    sf::Clock startupClock_;
+    bool firstFrameShown_ = false;
+
     // window & view
     unsigned int windowWidth_;
     unsigned int windowHeight_;
@@ -25,30 +52,49 @@ private:
     unsigned int MAX_CONTENT_WIDTH_ = 1280u;
 
     // assets
+    // mapped assets.pak; declared first so it outlives the font and music that stream from it
+    AssetPack pack_;
     sf::Font font_;
     bool hasFont_ = false;
-    sf::Texture texPlayer_, texBulletPlayer_, texBulletEnemy_;
-    sf::Texture texAlienTop_, texAlienMid_, texAlienBot_, texShield_;
+    // every sprite image lives in atlas_; these are its region ids (-1 if the file failed)
+    TextureAtlas atlas_;
+    int sprPlayer_ = -1, sprBulletPlayer_ = -1, sprBulletEnemy_ = -1;
+    int sprAlienTop_ = -1, sprAlienMid_ = -1, sprAlienBot_ = -1;
+    // full-field backdrop; too big for the atlas, only ever drawn into staticLayer_
+    sf::Texture bgTexture_;
+    bool hasBackground_ = false;
     sf::Music bgMusic_;
-    sf::SoundBuffer laserBuf_;
-    std::optional<sf::Sound> laserSound_;
 
-    // explosion sound pool
-    sf::SoundBuffer explosionBuf_;
-    bool explosionLoaded_ = false;
-    std::vector<sf::Sound> explosionSounds_;
-    size_t explosionSoundIndex_ = 0;
+    // every sound effect plays through voices_; ids are -1 if the file failed
+    VoiceManager voices_;
+    int sndLaser_ = -1, sndExplosion_ = -1, sndBossExplosion_ = -1;
 
     // UI / menus
     class Menu* menu_ = nullptr;
     class Menu* pauseMenu_ = nullptr;
 
-    // game objects
-    std::unique_ptr<class Formation> formation_;
-    std::vector<class Bullet> bullets_;
-    std::vector<class Bullet> enemyBullets_;
-    std::vector<class Shield> shields_;
-    std::unique_ptr<class Player> player_;
+    // game state (headless core) stepped on its own thread; Game sends it input and draws the
+    // snapshots it publishes. game_ counts the resets sent, so stale snapshots can be told apart
+    SimConfig simConfig_;
+    std::unique_ptr<SimThread> sim_;
+    std::uint32_t game_ = 0;
+    std::uint32_t syncedGame_ = 0;
+    SimEvents seen_;            // snapshot totals already turned into sounds / HUD updates
+
+    // physical keys behind each control (arrows + A/D, Space); a control is down while any is
+    static constexpr int INPUT_KEYS = 5;
+    bool keyDown_[INPUT_KEYS] = {};
+    bool controlDown_[InputBuffer::CONTROL_COUNT] = {};
+    bool replayDoneSeen_ = false;
+
+    // playfield quads, one draw call per texture
+    SpriteBatch batch_;
+    // background, shields and HUD frame, repainted only when invalidated
+    StaticLayer staticLayer_;
+    // one texel per shield mask bit; only rows that differ from the last upload are re-sent
+    std::vector<sf::Texture> shieldTextures_;
+    std::vector<std::vector<std::uint64_t>> shieldMasks_; // masks as last uploaded
+    std::vector<std::uint8_t> shieldPixels_; // RGBA staging for those uploads
 
     // HUD / controls
     sf::RectangleShape musicBtn_;
@@ -57,28 +103,35 @@ private:
     bool musicWasPlayingBeforeMenu_ = false;
 
     // score / lives
-    std::optional<sf::Text> scoreText_;
-    std::optional<sf::Text> livesText_;
-    int score_ = 0;
-    int lives_ = 0;
+    // HUD numbers: cached glyph quads, relaid out only when a value changes
+    std::optional<HudCounter> scoreHud_;
+    std::optional<HudCounter> livesHud_;
 
     // overlays & state
     bool pausedForResult_ = false;
     bool paused_ = false;
-    std::optional<sf::Text> overlayTitle_;
-    std::optional<sf::Text> overlaySub_;
+    // retained full-window layers; relaid out only on resize or text change
+    std::optional<Overlay> menuBackdrop_;
+    std::optional<Overlay> pauseOverlay_;
+    std::optional<Overlay> resultOverlay_;
 
     // timing and constants
     sf::Clock clock_;
-    float shootTimer_ = 0.f;
-    const float SHOOT_COOLDOWN = 0.6f;
-    const int SHIELD_HP = 9;
-
-    // RNG & enemy shooting
-    std::mt19937 rng_;
-    std::uniform_real_distribution<float> enemyShootDist_{0.8f, 1.8f};
-    std::uniform_int_distribution<int> enemyColDist_{0, 10};
-    float enemyShootTimer_ = 0.f;
+    float simStep_ = 1.f / 120.f;          // fixed sim step (seconds)
+
+    // replays (see Replay.h); handed to sim_ when it is created, which records / plays them
+    std::string recordPath_;
+    Replay replay_;
+    bool replaying_ = false;
+    bool fastForward_ = false;
+
+    // profiling (see Profiler.h); the graph is rebuilt only while profiling is on. sim_ has its
+    // own profiler for the sim.* phases, graphed per tick under the frame graph
+    Profiler profiler_;
+    bool profiling_ = false;
+    sf::VertexArray frameGraph_{ sf::PrimitiveType::Triangles };
+    std::vector<sf::Text> graphLegend_;
+    std::vector<sf::Text> simGraphLegend_;
 
     // app state
     enum class AppState { Menu, Playing };
@@ -86,27 +139,32 @@ private:
 
     // layout
     sf::Vector2f MARGIN_{12.f, 12.f};
-    const int WINDOW_COLS = 24;
-    const int WINDOW_ROWS = 25;
-    const int CELL_SIZE = 32;
-    const float HUD_HEIGHT = 64.f;
-    sf::Vector2f playerStart_;
-
-    // Enemy grid constants
-    static constexpr int ENEMY_COLS = 11;
-    static constexpr int ENEMY_ROWS = 5;
 
     // helpers
     bool loadAssets();
+    void renderLoading(float progress);
     void createView();
     void updateGameViewForWindow(unsigned int winW, unsigned int winH);
-    std::unique_ptr<class Formation> createFormation();
     void resetGameState();
-    bool trySpawnFromColumn(int col);
-    static bool rectsIntersect(const sf::FloatRect& a, const sf::FloatRect& b);
+    void layoutHud();
+    void onKey(sf::Keyboard::Key key, bool down);
+    void releaseAllKeys();
+    void setPaused(bool paused);
+    void syncSnapshot();
+    float interpolationAlpha() const;
+    void showResult(const std::string& title, sf::Color color);
+    void rebuildShieldTextures();
+    void uploadChangedShieldRows();
+    void uploadShieldRows(size_t shield, int begin, int end);
+    void queueShields();
+    void paintStaticLayer(sf::RenderTarget& target);
+    void drawFrameGraph();
+    void appendFrameGraph(const Profiler& profiler, float baseY, float rangeMs, float budgetMs, std::vector<sf::Text>& legend);
+    void writeTrace();
+    void drawBox(int sprite, const sf::FloatRect& rect, sf::Color fallback, sf::Color tint = sf::Color::White);
 
     // main loop pieces
     void handleEvents();
-    void update(float dt);
-    void render();
+    void update(float frameTime);
+    void render(float alpha);
 };
\ No newline at end of file
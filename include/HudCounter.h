@@ -0,0 +1,44 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// A fixed label followed by a number ("Score: 120"), drawn as glyph quads from the font's page.
+// The label and all ten digit glyphs are looked up once in the constructor; setValue() only
+// rewrites the quads of digits that changed and never allocates. Laid out like sf::Text
+// (baseline at characterSize), so it lines up with the other HUD text.
+class HudCounter : public sf::Drawable, public sf::Transformable {
+public:
+    static constexpr int MAX_DIGITS = 10;
+
+    HudCounter(const sf::Font& font, unsigned int characterSize, std::string_view label, sf::Color color = sf::Color::White);
+
+    // negative values show as 0
+    void setValue(int value);
+    int value() const { return value_; }
+
+    // advance width of label + current digits, and the vertical ink extent of every glyph the
+    // counter can show (constant, so centring never has to be redone)
+    float width() const { return digitX_[digitCount_]; }
+    float top() const { return top_; }
+    float bottom() const { return bottom_; }
+
+private:
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+    void writeGlyph(size_t firstVertex, const sf::Glyph& glyph, float x);
+
+    const sf::Font* font_;
+    unsigned int characterSize_;
+    sf::Color color_;
+    std::array<sf::Glyph, 10> digitGlyphs_;
+    std::vector<sf::Vertex> vertices_; // label quads, then MAX_DIGITS digit slots; sized once
+    size_t labelVertices_ = 0;
+    std::array<std::uint8_t, MAX_DIGITS> digits_{};
+    std::array<float, MAX_DIGITS + 1> digitX_{}; // pen position before each digit
+    int digitCount_ = 0;
+    int value_ = -1;
+    float top_ = 0.f;
+    float bottom_ = 0.f;
+};
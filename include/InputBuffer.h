@@ -0,0 +1,63 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include "Simulation.h"
+
+// Timestamped press/release events for the game controls, turned into one SimInput per tick.
+// Events are consumed up to each tick's own time, so a burst of catch-up ticks spreads them
+// out as they happened. A press that is released before the next tick still counts for that
+// tick: taps shorter than a frame move the ship one step or fire (cooldown permitting) instead
+// of being lost.
+class InputBuffer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class Control : std::uint8_t { Left, Right, Fire };
+    static constexpr int CONTROL_COUNT = 3;
+
+    struct KeyEvent {
+        Control control = Control::Fire;
+        bool down = false;
+        Clock::time_point time;
+    };
+
+    // events must arrive in time order
+    void push(const KeyEvent& e) { pending_.push_back(e); }
+    // applies events stamped at or before tickTime and returns the input for that tick
+    SimInput consume(Clock::time_point tickTime);
+    // fire press applied by the last consume(), if any (the start of an input-to-spawn span)
+    std::optional<Clock::time_point> firePress() const { return firePress_; }
+    // drops taps still pending; keys that are held stay held
+    void clearTaps();
+
+private:
+    std::vector<KeyEvent> pending_;
+    size_t next_ = 0;
+    bool held_[CONTROL_COUNT] = {};
+    bool tapped_[CONTROL_COUNT] = {};
+    std::optional<Clock::time_point> firePress_;
+};
+
+// Running input-to-spawn latency figures in milliseconds; keeps the last SAMPLES for percentiles.
+class LatencyStats {
+public:
+    static constexpr size_t SAMPLES = 512;
+
+    void add(float ms);
+    void clear();
+
+    size_t count() const { return count_; }
+    float meanMs() const { return count_ > 0 ? static_cast<float>(sumMs_ / static_cast<double>(count_)) : 0.f; }
+    float maxMs() const { return maxMs_; }
+    // p in [0, 1] over the retained samples
+    float percentileMs(float p) const;
+
+private:
+    std::vector<float> samples_;
+    size_t head_ = 0;
+    size_t count_ = 0;
+    double sumMs_ = 0.0;
+    float maxMs_ = 0.f;
+};
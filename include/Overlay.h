@@ -0,0 +1,27 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <optional>
+#include <string>
+
+// Full-window backdrop with an optional centred title and subtitle, drawn in window pixels
+// (default view). Origins and positions are cached: they are recomputed only when the text
+// changes or the target's size differs from the last draw, so a steady frame just replays
+// the shapes.
+class Overlay {
+public:
+    // font == nullptr: backdrop only
+    explicit Overlay(sf::Color backdrop, const sf::Font* font = nullptr, unsigned int titleSize = 64, unsigned int subtitleSize = 28);
+
+    void setText(const std::string& title, sf::Color titleColor, const std::string& subtitle);
+
+    void draw(sf::RenderTarget& target);
+
+private:
+    void layout(sf::Vector2u size);
+
+    sf::RectangleShape backdrop_;
+    std::optional<sf::Text> title_;
+    std::optional<sf::Text> subtitle_;
+    sf::Vector2u laidOutFor_{ 0, 0 };
+    bool dirty_ = true;
+};
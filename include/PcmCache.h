@@ -0,0 +1,34 @@
+#pragma once
+#include <SFML/Audio.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+
+// Raw PCM copies of decoded sound effects, so only the first launch pays for the MP3 decoder.
+//
+// One file per effect, "<dir>/<file stem>.pcm"; header fields little-endian:
+//   "GPCM" | u32 version | u64 sourceHash | u32 sampleRate | u32 channelCount
+//   channelCount x u8 sf::SoundChannel | u64 sampleCount | sampleCount x i16 (host order,
+//   the cache is rebuilt per machine and never shipped)
+//
+// sourceHash is FNV-1a over the compressed file, so replacing an .mp3 invalidates its entry.
+// load() is safe to call from several threads as long as the names differ.
+class PcmCache {
+public:
+    explicit PcmCache(std::filesystem::path dir);
+
+    enum class Result { Hit, Decoded, Failed };
+
+    // fills `out` from the cache, or decodes `source` and writes a fresh entry
+    Result load(const std::string& name, std::span<const std::byte> source, sf::SoundBuffer& out) const;
+
+    static std::uint64_t hash(std::span<const std::byte> data);
+
+private:
+    std::filesystem::path fileFor(const std::string& name) const;
+    bool read(const std::filesystem::path& file, std::uint64_t sourceHash, sf::SoundBuffer& out) const;
+    bool write(const std::filesystem::path& file, std::uint64_t sourceHash, const sf::SoundBuffer& buf) const;
+
+    std::filesystem::path dir_;
+};
@@ -3,29 +3,35 @@
 
 
 #pragma once
-#include <SFML/Graphics.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <SFML/Graphics/Rect.hpp>
 
 class Player {
 public:
-    Player(const sf::Texture* texture, const sf::Vector2f& startPos);
+    Player(const sf::Vector2f& startPos, const sf::Vector2f& size);
     void setHorizontalLimits(float left, float right);
 
     void update(float dt);
-    void draw(sf::RenderWindow& window) const;
 
     void moveLeft(float dt);
     void moveRight(float dt);
     void setPosition(const sf::Vector2f& pos);
     sf::FloatRect bounds() const;
 
+    // centre position now and at the end of the previous step (for render interpolation)
+    sf::Vector2f position() const { return position_; }
+    sf::Vector2f prevPosition() const { return prevPosition_; }
+    sf::Vector2f size() const { return size_; }
+
 private:
-    std::unique_ptr<sf::Sprite> sprite_;
-    sf::RectangleShape fallbackRect_;
     sf::Vector2f position_;
+    sf::Vector2f prevPosition_;
+    sf::Vector2f lastUpdatePos_; // position as of the last update()
+    sf::Vector2f size_;
     float speed_ = 150.f;
     float leftLimit_ = 16.f;
     float rightLimit_ = 800.f;
 };
 
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,104 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Scoped frame-phase timer. Each thread has at most one current Profiler; PROFILE_SCOPE("name")
+// records a begin/end pair into it, and with no current profiler the scope costs one
+// thread-local load and a branch. Building with GALAGA_NO_PROFILER removes the scopes entirely.
+//
+// Events go into a fixed ring buffer (oldest dropped) that writeChromeTrace() dumps as Chrome
+// trace_event JSON (chrome://tracing, Perfetto); several profilers (one per thread) can go into
+// one file on a shared timeline. Top-level scopes are also summed per frame for the last
+// FRAME_HISTORY frames, which is what an on-screen frame graph reads.
+//
+// Names must be string literals (or otherwise outlive the profiler): only the pointer is kept.
+class Profiler {
+public:
+    static constexpr size_t FRAME_HISTORY = 240;
+    static constexpr size_t MAX_PHASES = 12;
+
+    struct Frame {
+        float totalMs = 0.f;
+        std::array<float, MAX_PHASES> phaseMs{}; // indexed like phaseNames()
+    };
+
+    explicit Profiler(size_t eventCapacity = 1u << 16);
+
+    static Profiler* current() { return current_; }
+    static void setCurrent(Profiler* p) { current_ = p; }
+
+    void beginFrame();
+    void endFrame();
+
+    void beginScope(const char* name);
+    void endScope();
+
+    // frames oldest to newest; at most FRAME_HISTORY
+    size_t frameCount() const { return frameCount_; }
+    const Frame& frame(size_t i) const { return frames_[(frameHead_ + FRAME_HISTORY - frameCount_ + i) % FRAME_HISTORY]; }
+    const std::vector<const char*>& phaseNames() const { return phaseNames_; }
+
+    // one trace thread per profiler, tid 1, 2, ... in order; no profiler may be recording meanwhile
+    struct TraceThread {
+        const Profiler* profiler;
+        const char* name;
+    };
+    static bool writeChromeTrace(const std::string& path, const std::vector<TraceThread>& threads);
+    bool writeChromeTrace(const std::string& path) const { return writeChromeTrace(path, { { this, "main" } }); }
+
+private:
+    using Clock = std::chrono::steady_clock;
+    struct Event {
+        const char* name;
+        std::int64_t startNs;
+        std::int64_t durNs;
+        int depth;
+    };
+    struct Open {
+        const char* name;
+        std::int64_t startNs;
+    };
+
+    std::int64_t now() const { return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - epoch_).count(); }
+    // process-wide, so events from different profilers line up in a merged trace
+    static Clock::time_point processEpoch();
+    size_t phaseIndex(const char* name);
+
+    static thread_local Profiler* current_;
+
+    Clock::time_point epoch_;
+    std::vector<Event> events_;
+    size_t eventHead_ = 0;
+    size_t eventCount_ = 0;
+    std::vector<Open> stack_;
+
+    std::array<Frame, FRAME_HISTORY> frames_{};
+    size_t frameHead_ = 0;
+    size_t frameCount_ = 0;
+    Frame open_;
+    std::int64_t frameStartNs_ = 0;
+    bool inFrame_ = false;
+    std::vector<const char*> phaseNames_;
+};
+
+// RAII pair for the current thread's profiler; does nothing when there is none
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name) : p_(Profiler::current()) { if (p_) p_->beginScope(name); }
+    ~ProfileScope() { if (p_) p_->endScope(); }
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+private:
+    Profiler* p_;
+};
+
+#ifdef GALAGA_NO_PROFILER
+#define PROFILE_SCOPE(name) ((void)0)
+#else
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(name)
+#endif
@@ -0,0 +1,47 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Simulation.h"
+
+// Input log for one game: the seed the Simulation was reset with, the fixed step, and one byte
+// of input per simulation tick. Replaying the bytes against reset(seed) reproduces the game bit
+// for bit; the checksum of the final state is stored so playback can prove it did.
+//
+// File layout, little-endian:
+//   "GRPL" | u32 version | u32 seed | f32 step | u64 finalChecksum | u64 tickCount | tickCount x u8
+class Replay {
+public:
+    enum Bits : std::uint8_t {
+        Left = 1u << 0,
+        Right = 1u << 1,
+        Fire = 1u << 2,
+        Pause = 1u << 3, // tick spent paused: the simulation is not stepped
+    };
+
+    static std::uint8_t pack(const SimInput& input, bool paused);
+    static SimInput unpack(std::uint8_t bits);
+
+    void begin(std::uint32_t seed, float step);
+    void record(std::uint8_t bits) { ticks_.push_back(bits); }
+    void finish(std::uint64_t finalChecksum) { finalChecksum_ = finalChecksum; }
+
+    bool save(const std::string& path) const;
+    // false on any problem, with the reason in error(); files from another simulation version
+    // are refused rather than played back into a certain divergence
+    bool load(const std::string& path);
+    const std::string& error() const { return error_; }
+
+    std::uint32_t seed() const { return seed_; }
+    float step() const { return step_; }
+    std::uint64_t finalChecksum() const { return finalChecksum_; }
+    size_t size() const { return ticks_.size(); }
+    std::uint8_t at(size_t tick) const { return ticks_[tick]; }
+
+private:
+    std::uint32_t seed_ = 0;
+    float step_ = 1.f / 120.f;
+    std::uint64_t finalChecksum_ = 0;
+    std::vector<std::uint8_t> ticks_;
+    std::string error_;
+};
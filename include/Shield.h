@@ -1,22 +1,54 @@
 #pragma once
-#include <SFML/Graphics.hpp>
-#include <memory>
+#include <SFML/System/Vector2.hpp>
+#include <SFML/Graphics/Rect.hpp>
 #include <cstdint>
+#include <vector>
 
+// Destructible bunker. Occupancy is a packed bitmask with one bit per playfield unit, stored
+// as rows of 64-bit words (bit x%64 of word x/64). Overlap tests and crater stamping work a
+// word at a time, and erosion records which rows changed so a renderer can re-upload only
+// those.
 class Shield {
 public:
     Shield() = default;
-    Shield(const sf::Texture* tex, const sf::Vector2f& position, int hp = 3, const sf::Vector2f& size = {0.f,0.f});
+    Shield(const sf::Vector2f& position, const sf::Vector2f& size, float craterRadius = 7.f);
 
-    void draw(sf::RenderWindow& window) const;
     sf::FloatRect bounds() const;
-    bool takeDamage(int dmg = 1);
-    bool isActive() const;
+    bool isActive() const { return solid_ > 0; }
+
+    // exact test of `box` against the solid pixels; on a hit `impact` (mask pixels) is the
+    // first solid pixel met by something travelling down (movingDown) or up through the box
+    bool hitTest(const sf::FloatRect& box, bool movingDown, sf::Vector2i* impact = nullptr) const;
+    // clears a round crater centred on `center` (mask pixels); returns pixels removed
+    int erode(const sf::Vector2i& center);
+
+    int width() const { return width_; }
+    int height() const { return height_; }
+    int wordsPerRow() const { return words_; }
+    const std::uint64_t* row(int y) const { return &mask_[static_cast<size_t>(y) * words_]; }
+    bool solidAt(int x, int y) const { return (row(y)[x >> 6] >> (x & 63)) & 1u; }
+    int solidCount() const { return solid_; }
+    int initialCount() const { return initial_; }
+
+    // rows [dirtyBegin, dirtyEnd) changed since the last clearDirty(); empty if begin >= end
+    int dirtyBegin() const { return dirtyBegin_; }
+    int dirtyEnd() const { return dirtyEnd_; }
+    void clearDirty() { dirtyBegin_ = height_; dirtyEnd_ = 0; }
 
 private:
-    const sf::Texture* tex_ = nullptr;
-    std::unique_ptr<sf::Sprite> sprite_;
-    int hp_ = 0;
-    int maxHp_ = 0;
-    bool active_ = false;
-};
\ No newline at end of file
+    // bits [x0, x1] of a row, as the word-sized piece for word w (0 if the span misses it)
+    static std::uint64_t spanBits(int x0, int x1, int w);
+    int clearSpan(int y, int x0, int x1);
+
+    sf::Vector2f position_;
+    sf::Vector2f size_;
+    int width_ = 0;
+    int height_ = 0;
+    int words_ = 0;
+    std::vector<std::uint64_t> mask_;
+    int solid_ = 0;
+    int initial_ = 0;
+    float craterRadius_ = 7.f;
+    int dirtyBegin_ = 0;
+    int dirtyEnd_ = 0;
+};
@@ -0,0 +1,164 @@
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "InputBuffer.h"
+#include "Profiler.h"
+#include "Replay.h"
+#include "Simulation.h"
+#include "SpscQueue.h"
+#include "TripleBuffer.h"
+
+// Everything the front end needs to draw one simulation tick, copied out of the Simulation so
+// the render thread never reads state the sim thread is writing. Vectors keep their capacity
+// from one publish to the next.
+struct RenderSnapshot {
+    struct Box {
+        sf::FloatRect bounds;
+        sf::Vector2f prev;  // position one tick earlier (for interpolation)
+        sf::Vector2f pos;
+    };
+    struct EnemyView {
+        sf::FloatRect bounds; // relative to formationOrigin, or world space while diving
+        sf::Vector2f prev;    // diving only: centre one tick earlier (for interpolation)
+        sf::Vector2f pos;
+        int kind = 0;
+        bool diving = false;
+    };
+    struct ShieldView {
+        sf::FloatRect bounds;
+        int width = 0;
+        int height = 0;
+        int wordsPerRow = 0;
+        int solidCount = 0;  // changes whenever the mask does
+        std::vector<std::uint64_t> mask; // Shield's row layout
+        const std::uint64_t* row(int y) const { return &mask[static_cast<size_t>(y) * wordsPerRow]; }
+        bool solidAt(int x, int y) const { return (row(y)[x >> 6] >> (x & 63)) & 1u; }
+    };
+
+    std::uint32_t game = 0;         // bumps on every reset; totals below restart with it
+    std::uint64_t tick = 0;         // ticks stepped in this game
+    std::chrono::steady_clock::time_point tickTime; // when `tick` was stepped
+    bool paused = false;
+    bool replayFinished = false;
+
+    SimStatus status = SimStatus::Playing;
+    int score = 0;
+    int lives = 0;
+    // running totals of SimEvents; a reader that skipped snapshots still sees every event
+    int shotsFired = 0;
+    int enemiesKilled = 0;
+    int playerHits = 0;
+    int shieldHits = 0;
+
+    sf::Vector2f formationOrigin;
+    sf::Vector2f formationMove;     // Formation::lastMove()
+    std::vector<EnemyView> enemies; // live ones only
+    std::vector<Box> shots;
+    std::vector<Box> enemyShots;
+    Box player;
+    std::vector<ShieldView> shields;
+};
+
+// Runs a Simulation at a fixed rate on its own thread, so a slow present can't stall the game
+// and the game can't stall the present. Commands and timestamped key events go in through a
+// lock-free SPSC queue; each stepped tick comes out as a RenderSnapshot through a triple buffer.
+// Fire-press-to-shot latency is measured here and logged at the end of each game.
+//
+// The front end (one thread) calls everything public; the sim thread owns the Simulation and
+// the replay/recording state from start() until stop().
+class SimThread {
+public:
+    enum class Mode : std::uint8_t {
+        Idle,    // not ticking (menus)
+        Running, // stepping at the fixed rate
+        Paused,  // ticking without stepping; recordings log the paused ticks
+    };
+
+    explicit SimThread(const SimConfig& config, float step = 1.f / 120.f);
+    ~SimThread();
+
+    SimThread(const SimThread&) = delete;
+    SimThread& operator=(const SimThread&) = delete;
+
+    // before start(): save each game to `path`, or play `replay` back instead of live input
+    void recordTo(const std::string& path) { recordPath_ = path; }
+    void playReplay(const Replay& replay, bool fastForward);
+
+    void start();
+    void stop();
+
+    // new game with a fresh seed (the replay's seed during playback), then Running
+    void reset();
+    void setMode(Mode mode);
+    // a control going down or up at e.time (see InputBuffer); events must be sent in time order
+    void sendKey(const InputBuffer::KeyEvent& e);
+    // the sim.* scopes record into this thread's own profiler, one profiler frame per tick
+    void setProfiling(bool on);
+    // fn(const Profiler&) with the sim thread's profiler, locked against the tick writing it
+    template <typename Fn>
+    void withProfiler(Fn&& fn) const {
+        std::lock_guard<std::mutex> lock(profilerMutex_);
+        fn(profiler_);
+    }
+
+    // newest complete tick; true if it changed since the last call
+    bool acquire() { return snapshots_.acquire(); }
+    const RenderSnapshot& snapshot() const { return snapshots_.front(); }
+    float step() const { return step_; }
+
+private:
+    struct Command {
+        enum Kind : std::uint8_t { Key, SetMode, Reset, Profile } kind = Key;
+        InputBuffer::KeyEvent key;
+        Mode mode = Mode::Idle;
+        bool profile = false;
+    };
+
+    void send(const Command& cmd);
+    void loop();
+    void drainCommands();
+    void tick(std::chrono::steady_clock::time_point scheduled);
+    void reportLatency();
+    void finishRecording();
+    void finishReplay();
+    void publish();
+
+    const float step_;
+    Simulation sim_;
+    std::thread thread_;
+    std::atomic<bool> quit_{false};
+
+    SpscQueue<Command, 256> commands_;
+    TripleBuffer<RenderSnapshot> snapshots_;
+
+    // written by the sim thread only while profiling_, always under profilerMutex_
+    Profiler profiler_;
+    mutable std::mutex profilerMutex_;
+
+    // sim thread only
+    Mode mode_ = Mode::Idle;
+    InputBuffer inputs_;
+    LatencyStats fireLatency_;
+    std::uint32_t game_ = 0;
+    std::uint64_t tick_ = 0;
+    std::chrono::steady_clock::time_point tickTime_;
+    SimEvents totals_;
+    bool replayFinished_ = false;
+    bool profiling_ = false;
+
+    std::string recordPath_;
+    Replay recording_;
+    bool isRecording_ = false;
+    Replay replay_;
+    bool replaying_ = false;
+    bool fastForward_ = false;
+    size_t replayTick_ = 0;
+    std::chrono::steady_clock::time_point replayStart_;
+};
@@ -0,0 +1,141 @@
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <vector>
+#include <memory>
+#include <random>
+#include <cstdint>
+#include "Player.h"
+#include "BulletPool.h"
+#include "Formation.h"
+#include "Shield.h"
+#include "SpatialGrid.h"
+
+// Playfield layout and tuning. Defaults match the stock window grid used by Game.
+struct SimConfig {
+    sf::Vector2f margin{12.f, 12.f};
+    float hudHeight = 64.f;
+    int cellSize = 32;
+    int windowCols = 24;
+    int windowRows = 25;
+
+    int enemyCols = 11;
+    int enemyRows = 5;
+    int shieldCount = 4;
+    float shieldCraterRadius = 7.f; // playfield units carved out of a shield per bullet
+    int startLives = 3;
+    float shootCooldown = 0.6f;
+    int maxDivers = 2;         // enemies out of formation on dive attacks at once
+    float diveSpeed = 240.f;   // playfield units per second along a dive path
+    size_t playerBulletPool = 64;
+    size_t enemyBulletPool = 32;
+
+    // nominal hitboxes; Game shrinks them to each texture's aspect ratio
+    sf::Vector2f playerSize{50.f, 50.f};
+    sf::Vector2f enemySize{50.f, 45.f};
+    sf::Vector2f playerBulletSize{15.f, 15.f};
+    sf::Vector2f enemyBulletSize{15.f, 15.f};
+    sf::Vector2f shieldSize{140.f, 70.f};
+
+    float fieldWidth() const { return margin.x * 2.f + static_cast<float>(windowCols * cellSize); }
+    float fieldHeight() const { return margin.y * 2.f + hudHeight + static_cast<float>(windowRows * cellSize); }
+};
+
+// Player controls sampled for one simulation step.
+struct SimInput {
+    bool left = false;
+    bool right = false;
+    bool fire = false;
+};
+
+// What happened during the last step; the front end turns these into sounds and HUD updates.
+struct SimEvents {
+    int shotsFired = 0;
+    int enemiesKilled = 0;
+    int shieldHits = 0;
+    int playerHits = 0;
+};
+
+// Broadphase counters for the last step: narrowphase tests run vs. overlaps found.
+struct CollisionStats {
+    int candidates = 0;
+    int hits = 0;
+};
+
+enum class SimStatus { Playing, Won, Lost };
+
+// Headless game state: player, bullet pools, formation, shields, scoring, enemy fire and dives.
+// Never touches a window, audio device or font, so it can be stepped on machines without a GPU.
+class Simulation {
+public:
+    explicit Simulation(const SimConfig& config = SimConfig{}, std::uint32_t seed = 0);
+    ~Simulation();
+
+    void reset();
+    // reseeds the RNG first, so the same seed and inputs replay the same game
+    void reset(std::uint32_t seed);
+    void step(const SimInput& input, float dt);
+
+    // hash of everything the inputs can influence (score, lives, positions, alive enemies,
+    // bullets, shield pixels); equal checksums after a replay mean the run matched
+    std::uint64_t checksum() const;
+
+    const SimConfig& config() const { return config_; }
+    SimStatus status() const { return status_; }
+    const SimEvents& events() const { return events_; }
+    const CollisionStats& collisionStats() const { return collisionStats_; }
+    int score() const { return score_; }
+    int lives() const { return lives_; }
+
+    const Player& player() const { return *player_; }
+    const Formation& formation() const { return *formation_; }
+    const BulletPool& bullets() const { return bullets_; }
+    const BulletPool& enemyBullets() const { return enemyBullets_; }
+    const std::vector<Shield>& shields() const { return shields_; }
+
+    static bool rectsIntersect(const sf::FloatRect& a, const sf::FloatRect& b);
+
+private:
+    // tools/galaga_bench.cpp times the collision passes and enemy fire directly
+    friend struct BenchAccess;
+
+    std::unique_ptr<Formation> createFormation() const;
+    bool trySpawnFromColumn(int col);
+    void rebuildBroadphase();
+    void collidePlayerBullets();
+    void collideEnemyBullets();
+    void collideDivers();
+    void launchDive();
+    void damagePlayer();
+
+    SimConfig config_;
+    sf::Vector2f playerStart_;
+
+    std::unique_ptr<Player> player_;
+    std::unique_ptr<Formation> formation_;
+    BulletPool bullets_;
+    BulletPool enemyBullets_;
+    std::vector<Shield> shields_;
+
+    SimStatus status_ = SimStatus::Playing;
+    SimEvents events_;
+
+    // shields bucketed once per step (enemies go through Formation::sweepTest instead)
+    SpatialGrid grid_;
+    std::vector<int> candidates_;
+    CollisionStats collisionStats_;
+    int score_ = 0;
+    int lives_ = 0;
+    float shootTimer_ = 0.f;
+
+    // RNG & enemy shooting
+    std::mt19937 rng_;
+    std::uniform_real_distribution<float> enemyShootDist_{0.8f, 1.8f};
+    std::uniform_int_distribution<int> enemyColDist_; // index into Formation::liveColumns()
+    float enemyShootTimer_ = 0.f;
+
+    // dive attacks: paths come from DivePath::library()
+    std::uniform_real_distribution<float> diveDelayDist_{1.5f, 3.5f};
+    std::uniform_int_distribution<int> divePathDist_;
+    float diveTimer_ = 0.f;
+};
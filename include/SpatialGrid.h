@@ -0,0 +1,33 @@
+#pragma once
+#include <SFML/Graphics/Rect.hpp>
+#include <vector>
+#include <cstdint>
+
+// Uniform-grid broadphase. Boxes are bucketed into every cell they overlap; a query returns
+// each id sharing a cell with the probe exactly once. Boxes outside the area land in the
+// border cells, so nothing is ever lost. Cell storage is kept across clear() calls, so a
+// per-step rebuild does not allocate once warmed up.
+class SpatialGrid {
+public:
+    explicit SpatialGrid(const sf::FloatRect& area = {}, float cellSize = 64.f);
+
+    void clear();
+    void insert(int id, const sf::FloatRect& box);
+    // appends candidate ids to `out`; returns how many were appended
+    size_t query(const sf::FloatRect& box, std::vector<int>& out) const;
+
+private:
+    struct CellRange { int c0, r0, c1, r1; };
+    CellRange cellRange(const sf::FloatRect& box) const;
+
+    sf::FloatRect area_;
+    float invCell_ = 1.f;
+    int cols_ = 1;
+    int rows_ = 1;
+    std::vector<std::vector<int>> cells_;
+    std::vector<int> touched_; // non-empty cells, so clear() only visits what was filled
+
+    // per-id stamp to dedupe ids spanning several cells within one query
+    mutable std::vector<std::uint32_t> stamp_;
+    mutable std::uint32_t queryId_ = 0;
+};
@@ -0,0 +1,31 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+// Collects textured quads into one triangle VertexArray per texture and draws each array in a
+// single call on flush(). Layers are flushed in first-use order, so queue back-to-front by
+// texture (shields, enemies, bullets, player). Buffers keep their capacity between frames.
+class SpriteBatch {
+public:
+    // whole texture stretched over `rect`; tex == nullptr queues a flat coloured quad
+    void add(const sf::Texture* tex, const sf::FloatRect& rect, sf::Color color = sf::Color::White);
+    // `texRect` in texels, for sub-images of a shared texture
+    void add(const sf::Texture* tex, const sf::FloatRect& rect, const sf::FloatRect& texRect, sf::Color color = sf::Color::White);
+
+    void flush(sf::RenderTarget& target, const sf::RenderStates& states = sf::RenderStates::Default);
+
+    size_t lastDrawCalls() const { return lastDrawCalls_; }
+    size_t lastQuadCount() const { return lastQuadCount_; }
+
+private:
+    struct Layer {
+        const sf::Texture* texture = nullptr;
+        sf::VertexArray vertices{ sf::PrimitiveType::Triangles };
+    };
+    Layer& layerFor(const sf::Texture* tex);
+
+    std::vector<Layer> layers_;
+    size_t usedLayers_ = 0;
+    size_t lastDrawCalls_ = 0;
+    size_t lastQuadCount_ = 0;
+};
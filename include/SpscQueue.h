@@ -0,0 +1,37 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+// Bounded single-producer / single-consumer ring. push() and pop() never block or allocate;
+// each side only writes its own index, and the acquire/release pair on it publishes the slot.
+// One thread may push and one (other) thread may pop; anything more needs a different queue.
+template <typename T, size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    // false when full; the item is not queued
+    bool push(const T& item) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) == Capacity) return false;
+        slots_[tail & (Capacity - 1)] = item;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // false when empty
+    bool pop(T& out) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) return false;
+        out = slots_[head & (Capacity - 1)];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    std::array<T, Capacity> slots_{};
+    // on separate cache lines so the two threads don't bounce one line between them
+    alignas(64) std::atomic<size_t> head_{0};
+    alignas(64) std::atomic<size_t> tail_{0};
+};
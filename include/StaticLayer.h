@@ -0,0 +1,46 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+
+// Off-screen cache for playfield content that rarely changes (background, shields, HUD frame).
+// Callers mark what changed with invalidate(); refresh() repaints the texture only if some
+// layer is dirty, and every other frame costs a single textured quad. All layers share one
+// texture, so any invalidation repaints all of them: they are cheap, it is the per-frame
+// redraw that this avoids.
+class StaticLayer {
+public:
+    enum Layer : std::uint32_t {
+        Background = 1u << 0,
+        Shields = 1u << 1,
+        HudFrame = 1u << 2,
+        All = Background | Shields | HudFrame,
+    };
+
+    // size in playfield units (the game view's size); marks everything dirty
+    bool create(sf::Vector2u size);
+
+    void invalidate(std::uint32_t layers) { dirty_ |= layers; }
+    bool dirty() const { return dirty_ != 0; }
+
+    // paint(target) draws every layer, back to front, in playfield coordinates
+    template <typename Paint>
+    void refresh(Paint&& paint) {
+        if (!dirty_ || !valid_) return;
+        texture_.clear(sf::Color::Transparent);
+        paint(static_cast<sf::RenderTarget&>(texture_));
+        texture_.display();
+        dirty_ = 0;
+        ++repaints_;
+    }
+
+    bool valid() const { return valid_; }
+    const sf::Texture& texture() const { return texture_.getTexture(); }
+    sf::FloatRect rect() const;
+    unsigned int repaints() const { return repaints_; }
+
+private:
+    sf::RenderTexture texture_;
+    bool valid_ = false;
+    std::uint32_t dirty_ = All;
+    unsigned int repaints_ = 0;
+};
@@ -0,0 +1,40 @@
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <algorithm>
+#include <cmath>
+
+// Continuous collision helpers: a box that moved by `d` during a step is tested over the whole
+// path, so a fast bullet or a long step can't carry it past something between two positions.
+
+// box covering `a` at both ends of a move by `d` (and everything in between)
+inline sf::FloatRect sweptBounds(const sf::FloatRect& a, const sf::Vector2f& d) {
+    const sf::Vector2f lo(std::min(a.position.x, a.position.x + d.x), std::min(a.position.y, a.position.y + d.y));
+    return sf::FloatRect{ lo, { a.size.x + std::abs(d.x), a.size.y + std::abs(d.y) } };
+}
+
+// Earliest t in [0, 1] at which `a`, moving by `d`, touches the stationary `b` (0 if they already
+// overlap). Edges that just touch count, as in Simulation::rectsIntersect. Slab test per axis.
+inline bool sweepAabb(const sf::FloatRect& a, const sf::Vector2f& d, const sf::FloatRect& b, float& toi) {
+    float enter = 0.f;
+    float exit = 1.f;
+    const float aMin[2] = { a.position.x, a.position.y };
+    const float aMax[2] = { a.position.x + a.size.x, a.position.y + a.size.y };
+    const float bMin[2] = { b.position.x, b.position.y };
+    const float bMax[2] = { b.position.x + b.size.x, b.position.y + b.size.y };
+    const float dv[2] = { d.x, d.y };
+    for (int axis = 0; axis < 2; ++axis) {
+        if (dv[axis] == 0.f) {
+            if (aMax[axis] < bMin[axis] || bMax[axis] < aMin[axis]) return false;
+            continue;
+        }
+        float t0 = (bMin[axis] - aMax[axis]) / dv[axis];
+        float t1 = (bMax[axis] - aMin[axis]) / dv[axis];
+        if (t0 > t1) std::swap(t0, t1);
+        enter = std::max(enter, t0);
+        exit = std::min(exit, t1);
+        if (enter > exit) return false;
+    }
+    toi = enter;
+    return true;
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+// Packs many images into as few textures ("pages") as possible at load time, so sprites of
+// different kinds can share one SpriteBatch layer. Images are shelf-packed tallest first;
+// anything larger than a page gets a page of its own.
+class TextureAtlas {
+public:
+    // queues an image for packing; returns its region id
+    int add(sf::Image image);
+    // packs every queued image and uploads the pages (call once, after all add()s);
+    // queued images are released afterwards
+    bool build(unsigned int pageSize = 2048);
+
+    bool valid(int id) const { return id >= 0 && id < static_cast<int>(regions_.size()) && regions_[id].page >= 0; }
+    const sf::Texture* texture(int id) const { return valid(id) ? &pages_[regions_[id].page] : nullptr; }
+    // region in texels inside texture(id)
+    sf::FloatRect texRect(int id) const { return valid(id) ? regions_[id].rect : sf::FloatRect{}; }
+    size_t pageCount() const { return pages_.size(); }
+
+private:
+    struct Region {
+        int page = -1;
+        sf::FloatRect rect;
+    };
+
+    std::vector<sf::Image> pending_;
+    std::vector<Region> regions_;
+    std::vector<sf::Texture> pages_;
+};
@@ -0,0 +1,38 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// Lock-free hand-off of the latest value from one writer thread to one reader thread.
+// The writer fills back(), then publish() swaps it with the shared middle slot; the reader's
+// acquire() swaps the middle slot into front() if something newer was published. Neither side
+// ever waits, the writer never touches the slot being read, and values published in between
+// two acquire() calls are simply skipped.
+template <typename T>
+class TripleBuffer {
+public:
+    // writer side
+    T& back() { return slots_[back_]; }
+    void publish() {
+        const std::uint8_t old = middle_.exchange(static_cast<std::uint8_t>(back_ | FRESH), std::memory_order_acq_rel);
+        back_ = old & INDEX;
+    }
+
+    // reader side; returns true if front() changed
+    bool acquire() {
+        if (!(middle_.load(std::memory_order_relaxed) & FRESH)) return false;
+        const std::uint8_t old = middle_.exchange(front_, std::memory_order_acq_rel);
+        front_ = old & INDEX;
+        return true;
+    }
+    const T& front() const { return slots_[front_]; }
+
+private:
+    static constexpr std::uint8_t INDEX = 3;
+    static constexpr std::uint8_t FRESH = 4;
+
+    std::array<T, 3> slots_{};
+    std::uint8_t back_ = 0;                 // writer only
+    std::uint8_t front_ = 1;                // reader only
+    std::atomic<std::uint8_t> middle_{2};   // slot index | FRESH once published
+};
@@ -0,0 +1,59 @@
+#pragma once
+#include <SFML/Audio.hpp>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+// Fixed budget of sf::Sound voices shared by every sound effect.
+//
+// play() only records a trigger; flush() (once per rendered frame) starts them. Repeated
+// triggers of the same sound within a frame collapse into one voice. When every voice is
+// busy the lowest-priority, oldest voice is stolen, but never for a lower-priority sound.
+// A free voice that already has the buffer bound is preferred so it is not rebound.
+class VoiceManager {
+public:
+    struct Stats {
+        int started = 0;   // voices started by the last flush()
+        int deduped = 0;   // triggers merged into another one that frame
+        int stolen = 0;    // running voices cut short
+        int dropped = 0;   // triggers that found no voice
+        int rebinds = 0;   // setBuffer calls
+    };
+
+    explicit VoiceManager(size_t voiceCount = 12);
+    VoiceManager(const VoiceManager&) = delete;
+    VoiceManager& operator=(const VoiceManager&) = delete;
+
+    // takes ownership of the buffer; higher priority wins voices. returns the sound id
+    int addSound(sf::SoundBuffer buffer, int priority);
+
+    // ids < 0 (sound failed to load) are ignored
+    void play(int sound);
+    void flush();
+
+    size_t voiceCount() const { return voices_.size(); }
+    size_t activeVoices() const;
+    const Stats& lastStats() const { return stats_; }
+
+private:
+    struct Sound {
+        std::unique_ptr<sf::SoundBuffer> buffer; // stable address for sf::Sound
+        int priority;
+        int pendingTriggers = 0;
+    };
+    struct Voice {
+        std::optional<sf::Sound> sound;
+        int soundId = -1;
+        int priority = 0;
+        std::uint64_t startedAt = 0;
+    };
+
+    int pickVoice(int soundId, int priority);
+
+    std::vector<Sound> sounds_; // declared before voices_ so buffers outlive the sounds using them
+    std::vector<Voice> voices_;
+    std::vector<int> pending_;  // sound ids triggered this frame, in trigger order
+    std::uint64_t frame_ = 0;
+    Stats stats_;
+};
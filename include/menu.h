@@ -42,8 +42,12 @@ private:
     // fondo opcional (gestión dinámica para evitar default ctor issues)
     const sf::Texture* bgTex_ = nullptr;
     mutable std::unique_ptr<sf::Sprite> bgSprite_;
+    // fondo oscuro cuando no hay textura
+    mutable sf::RectangleShape fallbackBg_;
+    // tamaño de ventana para el que se calculó el fondo; solo se recalcula al cambiar
+    mutable sf::Vector2u bgLaidOutFor_{ 0, 0 };
 
-    // indicador triangular
+    // indicador triangular; rebuild() lo coloca junto a la opción seleccionada
     sf::ConvexShape pointer_;
     float pointerOffsetX_ = -48.f; // distancia relativa al borde izquierdo del texto
 
@@ -55,4 +59,5 @@ private:
     sf::Color colorSelected_ = sf::Color(230, 230, 230);
 
     void rebuild();
+    void layoutBackground(const sf::RenderWindow& window) const;
 };
\ No newline at end of file
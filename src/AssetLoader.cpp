@@ -0,0 +1,85 @@
+#include "AssetLoader.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iterator>
+
+AssetLoader::~AssetLoader() {
+    wait();
+}
+
+int AssetLoader::addImage(const std::string& path) {
+    jobs_.push_back(std::make_unique<Job>(Job{ Kind::Image, path, {}, std::nullopt, std::nullopt }));
+    return static_cast<int>(jobs_.size()) - 1;
+}
+
+int AssetLoader::addSound(const std::string& path) {
+    jobs_.push_back(std::make_unique<Job>(Job{ Kind::Sound, path, {}, std::nullopt, std::nullopt }));
+    return static_cast<int>(jobs_.size()) - 1;
+}
+
+int AssetLoader::addImage(std::span<const std::byte> data, const std::string& name) {
+    jobs_.push_back(std::make_unique<Job>(Job{ Kind::Image, name, data, std::nullopt, std::nullopt }));
+    return static_cast<int>(jobs_.size()) - 1;
+}
+
+int AssetLoader::addSound(std::span<const std::byte> data, const std::string& name) {
+    jobs_.push_back(std::make_unique<Job>(Job{ Kind::Sound, name, data, std::nullopt, std::nullopt }));
+    return static_cast<int>(jobs_.size()) - 1;
+}
+
+void AssetLoader::start(unsigned int threads) {
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min<unsigned int>(threads, static_cast<unsigned int>(jobs_.size()));
+    for (unsigned int i = 0; i < threads; ++i) workers_.emplace_back(&AssetLoader::workerLoop, this);
+}
+
+void AssetLoader::wait() {
+    for (auto &t : workers_) {
+        if (t.joinable()) t.join();
+    }
+}
+
+void AssetLoader::workerLoop() {
+    for (;;) {
+        size_t idx = next_.fetch_add(1, std::memory_order_relaxed);
+        if (idx >= jobs_.size()) return;
+        Job &job = *jobs_[idx];
+        const auto t0 = std::chrono::steady_clock::now();
+        if (job.kind == Kind::Image) {
+            sf::Image img;
+            bool loaded = job.data.empty() ? img.loadFromFile(job.path) : img.loadFromMemory(job.data.data(), job.data.size());
+            if (loaded) job.image = std::move(img);
+        } else {
+            sf::SoundBuffer buf;
+            bool loaded = false;
+            if (pcmCache_) {
+                // the cache key hashes the compressed bytes, so loose files are read whole first
+                std::vector<char> fileBytes;
+                std::span<const std::byte> source = job.data;
+                if (source.empty()) {
+                    std::ifstream in(job.path, std::ios::binary);
+                    fileBytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+                    source = std::as_bytes(std::span<const char>(fileBytes));
+                }
+                auto result = source.empty() ? PcmCache::Result::Failed : pcmCache_->load(job.path, source, buf);
+                loaded = result != PcmCache::Result::Failed;
+                job.fromCache = result == PcmCache::Result::Hit;
+            } else {
+                loaded = job.data.empty() ? buf.loadFromFile(job.path) : buf.loadFromMemory(job.data.data(), job.data.size());
+            }
+            if (loaded) job.sound = std::move(buf);
+        }
+        job.loadMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        // release: the main thread reads the job only after seeing the count move
+        completed_.fetch_add(1, std::memory_order_release);
+    }
+}
+
+std::optional<sf::Image> AssetLoader::takeImage(int id) {
+    return std::move(jobs_[id]->image);
+}
+
+std::optional<sf::SoundBuffer> AssetLoader::takeSound(int id) {
+    return std::move(jobs_[id]->sound);
+}
@@ -0,0 +1,154 @@
+#include "AssetPack.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static constexpr char PACK_MAGIC[4] = { 'G', 'P', 'A', 'K' };
+static constexpr std::uint32_t PACK_VERSION = 1;
+static constexpr std::uint64_t BLOB_ALIGN = 16;
+
+template <typename T>
+static T readLE(const std::byte* p) {
+    T v = 0;
+    for (size_t i = 0; i < sizeof(T); ++i) v |= static_cast<T>(std::to_integer<std::uint8_t>(p[i])) << (8 * i);
+    return v;
+}
+
+template <typename T>
+static void writeLE(std::ostream& out, T v) {
+    char buf[sizeof(T)];
+    for (size_t i = 0; i < sizeof(T); ++i) buf[i] = static_cast<char>((v >> (8 * i)) & 0xFF);
+    out.write(buf, sizeof(T));
+}
+
+AssetPack::~AssetPack() {
+    close();
+}
+
+bool AssetPack::open(const std::string& path) {
+    close();
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) { CloseHandle(file); return false; }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) { CloseHandle(file); return false; }
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) { CloseHandle(mapping); CloseHandle(file); return false; }
+    file_ = file;
+    mapping_ = mapping;
+    data_ = static_cast<const std::byte*>(view);
+    size_ = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st{};
+    if (fstat(fd, &st) != 0 || st.st_size == 0) { ::close(fd); return false; }
+    void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // the mapping keeps the file alive
+    if (view == MAP_FAILED) return false;
+    data_ = static_cast<const std::byte*>(view);
+    size_ = static_cast<size_t>(st.st_size);
+#endif
+
+    // header + index; any inconsistency rejects the whole pack
+    bool ok = size_ >= 16 && std::memcmp(data_, PACK_MAGIC, 4) == 0 && readLE<std::uint32_t>(data_ + 4) == PACK_VERSION;
+    std::uint32_t count = ok ? readLE<std::uint32_t>(data_ + 8) : 0;
+    std::uint32_t indexBytes = ok ? readLE<std::uint32_t>(data_ + 12) : 0;
+    // every index entry takes at least 20 bytes, so a corrupt count can't size the reserve below
+    ok = ok && 16 + static_cast<std::uint64_t>(indexBytes) <= size_ && count <= indexBytes / 20;
+    size_t cursor = 16;
+    const size_t indexEnd = 16 + static_cast<size_t>(indexBytes);
+    if (ok) entries_.reserve(count);
+    for (std::uint32_t i = 0; ok && i < count; ++i) {
+        if (cursor + 20 > indexEnd) { ok = false; break; }
+        Entry e;
+        e.offset = readLE<std::uint64_t>(data_ + cursor);
+        e.size = readLE<std::uint64_t>(data_ + cursor + 8);
+        std::uint32_t nameLen = readLE<std::uint32_t>(data_ + cursor + 16);
+        cursor += 20;
+        if (cursor + nameLen > indexEnd || e.offset > size_ || e.size > size_ - e.offset) { ok = false; break; }
+        e.name = std::string_view(reinterpret_cast<const char*>(data_ + cursor), nameLen);
+        cursor += nameLen;
+        entries_.push_back(e);
+    }
+    if (!ok) {
+        std::cerr << "[WARN] " << path << " is not a valid asset pack\n";
+        close();
+        return false;
+    }
+    std::sort(entries_.begin(), entries_.end(), [](const Entry& a, const Entry& b) { return a.name < b.name; });
+    return true;
+}
+
+void AssetPack::close() {
+    entries_.clear();
+    if (!data_) return;
+#ifdef _WIN32
+    UnmapViewOfFile(data_);
+    CloseHandle(static_cast<HANDLE>(mapping_));
+    CloseHandle(static_cast<HANDLE>(file_));
+    mapping_ = file_ = nullptr;
+#else
+    munmap(const_cast<std::byte*>(data_), size_);
+#endif
+    data_ = nullptr;
+    size_ = 0;
+}
+
+std::span<const std::byte> AssetPack::find(std::string_view name) const {
+    auto it = std::lower_bound(entries_.begin(), entries_.end(), name, [](const Entry& e, std::string_view n) { return e.name < n; });
+    if (it == entries_.end() || it->name != name) return {};
+    return { data_ + it->offset, static_cast<size_t>(it->size) };
+}
+
+bool AssetPack::write(const std::string& outPath, const std::vector<std::pair<std::string, std::string>>& files) {
+    std::vector<std::string> blobs;
+    blobs.reserve(files.size());
+    std::uint64_t indexBytes = 0;
+    for (const auto& [name, path] : files) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) { std::cerr << "[ERROR] could not read " << path << "\n"; return false; }
+        blobs.emplace_back(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        indexBytes += 20 + name.size();
+    }
+
+    std::ofstream out(outPath, std::ios::binary | std::ios::trunc);
+    if (!out) { std::cerr << "[ERROR] could not write " << outPath << "\n"; return false; }
+    out.write(PACK_MAGIC, 4);
+    writeLE<std::uint32_t>(out, PACK_VERSION);
+    writeLE<std::uint32_t>(out, static_cast<std::uint32_t>(files.size()));
+    writeLE<std::uint32_t>(out, static_cast<std::uint32_t>(indexBytes));
+
+    auto align = [](std::uint64_t v) { return (v + BLOB_ALIGN - 1) & ~(BLOB_ALIGN - 1); };
+    std::uint64_t offset = align(16 + indexBytes);
+    for (size_t i = 0; i < files.size(); ++i) {
+        writeLE<std::uint64_t>(out, offset);
+        writeLE<std::uint64_t>(out, blobs[i].size());
+        writeLE<std::uint32_t>(out, static_cast<std::uint32_t>(files[i].first.size()));
+        out.write(files[i].first.data(), static_cast<std::streamsize>(files[i].first.size()));
+        offset = align(offset + blobs[i].size());
+    }
+
+    std::uint64_t written = 16 + indexBytes;
+    for (const auto& blob : blobs) {
+        std::uint64_t start = align(written);
+        for (; written < start; ++written) out.put('\0');
+        out.write(blob.data(), static_cast<std::streamsize>(blob.size()));
+        written += blob.size();
+    }
+    return static_cast<bool>(out);
+}
@@ -0,0 +1,126 @@
+#include "BatchRunner.h"
+#include <algorithm>
+
+BatchRunner::BatchRunner(size_t instances, const SimConfig& config, unsigned threads, std::uint32_t seed)
+    : instances_(instances) {
+    for (size_t i = 0; i < instances_.size(); ++i) {
+        Instance& in = instances_[i];
+        in.seed = seed + static_cast<std::uint32_t>(i);
+        in.sim = std::make_unique<Simulation>(config, in.seed);
+        observe(*in.sim, in.obs);
+    }
+
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    // the thread calling step() takes chunks as well, so it counts as one of them
+    for (unsigned t = 1; t < threads; ++t) workers_.emplace_back([this] { workerLoop(); });
+}
+
+BatchRunner::~BatchRunner() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        quit_ = true;
+    }
+    wake_.notify_all();
+    for (auto &w : workers_) w.join();
+}
+
+void BatchRunner::reset(std::uint32_t seed) {
+    for (size_t i = 0; i < instances_.size(); ++i) resetInstance(i, seed + static_cast<std::uint32_t>(i));
+}
+
+void BatchRunner::resetInstance(size_t i, std::uint32_t seed) {
+    Instance& in = instances_[i];
+    in.seed = seed;
+    in.sim->reset(seed);
+    observe(*in.sim, in.obs);
+}
+
+void BatchRunner::step(std::span<const SimInput> inputs, float dt, int ticks) {
+    if (inputs.size() != instances_.size() || ticks <= 0 || instances_.empty()) return;
+
+    {
+        // a worker that woke for the last job after it was already done can still be inside
+        // runChunks() reading it; let it leave before the job changes under it
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this] { return busy_ == 0; });
+        inputs_ = inputs;
+        dt_ = dt;
+        ticks_ = ticks;
+        // ~8 chunks per thread: games that end early leave room to rebalance, and the shared
+        // counter is touched a few hundred times per step rather than once per game
+        chunkSize_ = std::max<size_t>(1, instances_.size() / (static_cast<size_t>(threadCount()) * 8));
+        chunkCount_ = (instances_.size() + chunkSize_ - 1) / chunkSize_;
+        nextChunk_.store(0, std::memory_order_relaxed);
+        chunksLeft_.store(chunkCount_, std::memory_order_relaxed);
+        ++generation_;
+    }
+    wake_.notify_all();
+
+    runChunks();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return chunksLeft_.load(std::memory_order_acquire) == 0 && busy_ == 0; });
+}
+
+void BatchRunner::workerLoop() {
+    std::uint64_t seen = 0;
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        wake_.wait(lock, [&] { return quit_ || generation_ != seen; });
+        if (quit_) return;
+        seen = generation_;
+        ++busy_;
+        lock.unlock();
+        runChunks();
+        lock.lock();
+        if (--busy_ == 0) done_.notify_all();
+    }
+}
+
+void BatchRunner::runChunks() {
+    std::uint64_t steps = 0;
+    for (;;) {
+        const size_t c = nextChunk_.fetch_add(1, std::memory_order_relaxed);
+        if (c >= chunkCount_) break;
+        const size_t end = std::min(instances_.size(), (c + 1) * chunkSize_);
+        for (size_t i = c * chunkSize_; i < end; ++i) steps += static_cast<std::uint64_t>(stepInstance(instances_[i], inputs_[i]));
+        if (chunksLeft_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            // last chunk: take the lock so the notify can't slip in before step() starts waiting
+            std::lock_guard<std::mutex> lock(mutex_);
+            done_.notify_all();
+        }
+    }
+    totalSteps_.fetch_add(steps, std::memory_order_relaxed);
+}
+
+int BatchRunner::stepInstance(Instance& in, const SimInput& input) {
+    Simulation& sim = *in.sim;
+    if (sim.status() != SimStatus::Playing) {
+        if (!autoReset_) return 0;
+        ++in.obs.episodes;
+        in.seed += 0x9E3779B9u; // next episode's seed; stays reproducible from the batch seed
+        sim.reset(in.seed);
+    }
+
+    // stop on the step that ends the game, so the observation shows how it ended
+    int steps = 0;
+    while (steps < ticks_ && sim.status() == SimStatus::Playing) {
+        sim.step(input, dt_);
+        ++steps;
+    }
+    observe(sim, in.obs);
+    return steps;
+}
+
+void BatchRunner::observe(const Simulation& sim, Observation& obs) {
+    obs.status = sim.status();
+    obs.score = sim.score();
+    obs.lives = sim.lives();
+    obs.playerX = sim.player().position().x;
+    obs.aliveMask.assign(sim.formation().aliveBits().begin(), sim.formation().aliveBits().end());
+
+    obs.playerBullets.clear();
+    for (int id : sim.bullets().active()) obs.playerBullets.push_back(sim.bullets().position(id));
+    obs.enemyBullets.clear();
+    for (int id : sim.enemyBullets().active()) obs.enemyBullets.push_back(sim.enemyBullets().position(id));
+}
@@ -0,0 +1,62 @@
+#include "BulletPool.h"
+
+BulletPool::BulletPool(size_t capacity, const sf::Vector2f& size)
+: posX_(capacity), posY_(capacity)
+, prevX_(capacity), prevY_(capacity)
+, velX_(capacity), velY_(capacity)
+, halfW_(capacity, size.x / 2.f), halfH_(capacity, size.y / 2.f)
+, denseIndex_(capacity, -1)
+{
+    active_.reserve(capacity);
+    freeList_.reserve(capacity);
+    clear();
+}
+
+int BulletPool::spawn(const sf::Vector2f& pos, const sf::Vector2f& vel) {
+    if (freeList_.empty()) return -1;
+    int id = freeList_.back();
+    freeList_.pop_back();
+    posX_[id] = prevX_[id] = pos.x;
+    posY_[id] = prevY_[id] = pos.y;
+    velX_[id] = vel.x;
+    velY_[id] = vel.y;
+    denseIndex_[id] = static_cast<int>(active_.size());
+    active_.push_back(id);
+    return id;
+}
+
+void BulletPool::retire(int id) {
+    int dense = denseIndex_[id];
+    if (dense < 0) return;
+    int last = active_.back();
+    active_[dense] = last;
+    denseIndex_[last] = dense;
+    active_.pop_back();
+    denseIndex_[id] = -1;
+    freeList_.push_back(id);
+}
+
+void BulletPool::clear() {
+    active_.clear();
+    freeList_.clear();
+    // hand out low ids first so a fresh pool fills front to back
+    for (size_t i = capacity(); i-- > 0;) {
+        freeList_.push_back(static_cast<int>(i));
+        denseIndex_[i] = -1;
+    }
+}
+
+void BulletPool::update(float dt) {
+    for (size_t k = 0; k < active_.size();) {
+        int id = active_[k];
+        prevX_[id] = posX_[id];
+        prevY_[id] = posY_[id];
+        posX_[id] += velX_[id] * dt;
+        posY_[id] += velY_[id] * dt;
+
+        float top = posY_[id] - halfH_[id];
+        float bottom = posY_[id] + halfH_[id];
+        if (bottom < -200.f || top > 5000.f) { retire(id); continue; }
+        ++k;
+    }
+}
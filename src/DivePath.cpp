@@ -0,0 +1,110 @@
+#include "DivePath.h"
+#include <algorithm>
+#include <cmath>
+
+// dense samples per curve segment before resampling; plenty for curves a few hundred units long
+static constexpr int SUBDIVISIONS = 32;
+
+static float distance(const sf::Vector2f& a, const sf::Vector2f& b) {
+    const sf::Vector2f d = b - a;
+    return std::sqrt(d.x * d.x + d.y * d.y);
+}
+
+DivePath DivePath::catmullRom(const std::vector<sf::Vector2f>& points) {
+    if (points.size() < 2) return bake(points);
+    // phantom end points continue the first and last segments
+    std::vector<sf::Vector2f> p;
+    p.reserve(points.size() + 2);
+    p.push_back(points[0] * 2.f - points[1]);
+    p.insert(p.end(), points.begin(), points.end());
+    p.push_back(points[points.size() - 1] * 2.f - points[points.size() - 2]);
+
+    std::vector<sf::Vector2f> line{ points.front() };
+    for (size_t s = 1; s + 2 < p.size(); ++s) {
+        const sf::Vector2f& p0 = p[s - 1];
+        const sf::Vector2f& p1 = p[s];
+        const sf::Vector2f& p2 = p[s + 1];
+        const sf::Vector2f& p3 = p[s + 2];
+        // centripetal knots (sqrt of chord length) keep tight turns from overshooting into cusps
+        const float t0 = 0.f;
+        const float t1 = t0 + std::max(std::sqrt(distance(p0, p1)), 1e-3f);
+        const float t2 = t1 + std::max(std::sqrt(distance(p1, p2)), 1e-3f);
+        const float t3 = t2 + std::max(std::sqrt(distance(p2, p3)), 1e-3f);
+        for (int i = 1; i <= SUBDIVISIONS; ++i) {
+            const float t = t1 + (t2 - t1) * static_cast<float>(i) / SUBDIVISIONS;
+            const sf::Vector2f a1 = p0 * ((t1 - t) / (t1 - t0)) + p1 * ((t - t0) / (t1 - t0));
+            const sf::Vector2f a2 = p1 * ((t2 - t) / (t2 - t1)) + p2 * ((t - t1) / (t2 - t1));
+            const sf::Vector2f a3 = p2 * ((t3 - t) / (t3 - t2)) + p3 * ((t - t2) / (t3 - t2));
+            const sf::Vector2f b1 = a1 * ((t2 - t) / (t2 - t0)) + a2 * ((t - t0) / (t2 - t0));
+            const sf::Vector2f b2 = a2 * ((t3 - t) / (t3 - t1)) + a3 * ((t - t1) / (t3 - t1));
+            line.push_back(b1 * ((t2 - t) / (t2 - t1)) + b2 * ((t - t1) / (t2 - t1)));
+        }
+    }
+    return bake(line);
+}
+
+DivePath DivePath::bezier(const std::vector<sf::Vector2f>& points) {
+    if (points.empty()) return bake(points);
+    std::vector<sf::Vector2f> line{ points.front() };
+    for (size_t s = 0; s + 3 < points.size(); s += 3) {
+        const sf::Vector2f& p0 = points[s];
+        const sf::Vector2f& c0 = points[s + 1];
+        const sf::Vector2f& c1 = points[s + 2];
+        const sf::Vector2f& p1 = points[s + 3];
+        for (int i = 1; i <= SUBDIVISIONS; ++i) {
+            const float t = static_cast<float>(i) / SUBDIVISIONS;
+            const float u = 1.f - t;
+            line.push_back(p0 * (u * u * u) + c0 * (3.f * u * u * t) + c1 * (3.f * u * t * t) + p1 * (t * t * t));
+        }
+    }
+    return bake(line);
+}
+
+DivePath DivePath::bake(const std::vector<sf::Vector2f>& polyline) {
+    DivePath path;
+    if (polyline.empty()) return path;
+
+    float total = 0.f;
+    for (size_t i = 1; i < polyline.size(); ++i) total += distance(polyline[i - 1], polyline[i]);
+    const size_t entries = static_cast<size_t>(std::ceil(total / STEP)) + 1;
+    path.lut_.reserve(entries);
+    path.lut_.push_back(polyline.front());
+
+    // walk the polyline once, dropping a table entry every STEP units of arc length
+    size_t seg = 1;
+    float segStart = 0.f; // arc length at polyline[seg - 1]
+    for (size_t k = 1; k < entries; ++k) {
+        const float target = std::min(static_cast<float>(k) * STEP, total);
+        while (seg < polyline.size()) {
+            const float len = distance(polyline[seg - 1], polyline[seg]);
+            if (segStart + len >= target || seg + 1 == polyline.size()) {
+                const float f = len > 0.f ? std::clamp((target - segStart) / len, 0.f, 1.f) : 1.f;
+                path.lut_.push_back(polyline[seg - 1] + (polyline[seg] - polyline[seg - 1]) * f);
+                break;
+            }
+            segStart += len;
+            ++seg;
+        }
+    }
+    // the last entry may sit less than STEP past its neighbour; at() clamps there
+    path.length_ = total;
+    return path;
+}
+
+const std::vector<DivePath>& DivePath::library() {
+    static const std::vector<DivePath> paths = {
+        // climb out, loop back over the slot, then a long S down the field
+        catmullRom({ { 0.f, 0.f }, { -25.f, -45.f }, { -80.f, -55.f }, { -115.f, -10.f }, { -95.f, 45.f },
+                     { -40.f, 60.f }, { 20.f, 120.f }, { 80.f, 260.f }, { 40.f, 420.f }, { -40.f, 560.f },
+                     { -60.f, 700.f } }),
+        // peel off sideways and swoop down in wide arcs
+        bezier({ { 0.f, 0.f }, { 0.f, -60.f }, { -90.f, -60.f }, { -90.f, 0.f },
+                 { -90.f, 80.f }, { 60.f, 160.f }, { 60.f, 300.f },
+                 { 60.f, 420.f }, { -140.f, 420.f }, { -120.f, 560.f },
+                 { -110.f, 650.f }, { -20.f, 700.f }, { -20.f, 760.f } }),
+        // short hop, then a zig-zag straight at the player's row
+        catmullRom({ { 0.f, 0.f }, { -30.f, -30.f }, { -60.f, 0.f }, { -20.f, 80.f }, { 80.f, 180.f },
+                     { -40.f, 300.f }, { 80.f, 420.f }, { -40.f, 540.f }, { 40.f, 660.f } }),
+    };
+    return paths;
+}
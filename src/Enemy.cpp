@@ -1,62 +1,55 @@
 #include "Enemy.h"
-#include <memory>
+#include "DivePath.h"
+#include <cmath>
 
-
-static constexpr float TARGET_ENEMY_W = 50.f;
-static constexpr float TARGET_ENEMY_H = 45.f;
-
-Enemy::Enemy(const sf::Texture* texture, const sf::Vector2f& startPos) {
-    if (texture) {
-        sprite_ = std::make_unique<sf::Sprite>(*texture);
-        auto local = sprite_->getLocalBounds();
-
-        float scaleX = TARGET_ENEMY_W / local.size.x;
-        float scaleY = TARGET_ENEMY_H / local.size.y;
-        float scale = std::min(scaleX, scaleY);
-        sprite_->setScale({ scale, scale });
-
-        auto newLocal = sprite_->getLocalBounds();
-        sprite_->setOrigin({ newLocal.size.x / 2.f, newLocal.size.y / 2.f });
-        sprite_->setPosition(startPos);
-    } else {
-        fallbackRect_.setSize({TARGET_ENEMY_W, TARGET_ENEMY_H});
-        fallbackRect_.setOrigin(fallbackRect_.getSize() / 2.f);
-        fallbackRect_.setFillColor(sf::Color(200,80,80));
-        fallbackRect_.setPosition(startPos);
-    }
-    leftLimit_ = startPos.x - 80.f;
-    rightLimit_ = startPos.x + 80.f;
+Enemy::Enemy(const sf::Vector2f& slot, const sf::Vector2f& size, int kind)
+: slot_(slot), size_(size), kind_(kind) {
 }
 
-void Enemy::update(float dt) {
-    if (!active_) return;
+void Enemy::startDive(const DivePath& path, const sf::Vector2f& start, bool mirror, float speed) {
+    motion_ = Motion::Diving;
+    path_ = &path;
+    distance_ = 0.f;
+    speed_ = speed;
+    mirror_ = mirror;
+    start_ = start;
+    pos_ = prevPos_ = start;
 }
 
-void Enemy::draw(sf::RenderWindow& window) const {
-    if (!active_) return;
-    if (sprite_) window.draw(*sprite_);
-    else window.draw(fallbackRect_);
+bool Enemy::update(float dt, const sf::Vector2f& slotWorld, float exitY) {
+    if (!active_ || motion_ == Motion::InFormation) return false;
+    prevPos_ = pos_;
+    const float step = speed_ * dt;
+
+    if (motion_ == Motion::Diving) {
+        distance_ += step;
+        if (distance_ <= path_->length()) {
+            pos_ = start_ + path_->at(distance_, mirror_);
+            return false;
+        }
+        // past the end of the path: keep falling until clear of the field, then wrap to the top
+        pos_.y += step;
+        if (pos_.y - size_.y / 2.f <= exitY) return false;
+        motion_ = Motion::Returning;
+        pos_ = prevPos_ = { slotWorld.x, -size_.y };
+        return false;
+    }
+
+    const sf::Vector2f d = slotWorld - pos_;
+    const float len = std::sqrt(d.x * d.x + d.y * d.y);
+    if (len > step) {
+        pos_ += d * (step / len);
+        return false;
+    }
+    pos_ = slotWorld;
+    motion_ = Motion::InFormation;
+    path_ = nullptr;
+    return true;
 }
 
 void Enemy::setActive(bool v) { active_ = v; }
 bool Enemy::isActive() const { return active_; }
 
-sf::FloatRect Enemy::bounds() const {
-    if (sprite_) return sprite_->getGlobalBounds();
-    return fallbackRect_.getGlobalBounds();
-}
-
-void Enemy::setPosition(const sf::Vector2f& pos) {
-    if (sprite_) sprite_->setPosition(pos);
-    else fallbackRect_.setPosition(pos);
+sf::FloatRect Enemy::localBounds() const {
+    return sf::FloatRect{ slot_ - size_ / 2.f, size_ };
 }
-
-sf::Vector2f Enemy::getPosition() const {
-    if (sprite_) return sprite_->getPosition();
-    return fallbackRect_.getPosition();
-}
-
-void Enemy::moveBy(const sf::Vector2f& delta) {
-    if (sprite_) sprite_->move(delta);
-    else fallbackRect_.move(delta);
-}
\ No newline at end of file
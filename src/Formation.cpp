@@ -1,18 +1,23 @@
 #include "Formation.h"
+#include "DivePath.h"
+#include "Sweep.h"
 #include <algorithm>
+#include <cmath>
 
-Formation::Formation(const sf::Texture* topTex,
-                     const sf::Texture* midTex,
-                     const sf::Texture* botTex,
-                     int cols, int rows,
+Formation::Formation(int cols, int rows,
                      const sf::Vector2f& startPos,
                      float spacingX, float spacingY,
+                     const sf::Vector2f& enemySize,
                      float speed, float dropAmount)
-: topTex_(topTex), midTex_(midTex), botTex_(botTex),
+: enemySize_(enemySize),
   cols_(cols), rows_(rows), startPos_(startPos),
   spacingX_(spacingX), spacingY_(spacingY),
   speed_(speed), dropAmount_(dropAmount)
 {
+    populate();
+}
+
+void Formation::populate() {
     enemies_.clear();
 
     int topCount = 1;
@@ -24,109 +29,186 @@ Formation::Formation(const sf::Texture* topTex,
     if (botCount < 0) { botCount = 0; midCount = rows_ - topCount; }
 
     for (int r = 0; r < rows_; ++r) {
-        const sf::Texture* tex = midTex_;
+        int kind = KIND_MID;
         if (r < topCount) {
-            tex = topTex_;
+            kind = KIND_TOP;
         } else if (r < topCount + midCount) {
-            tex = midTex_;
+            kind = KIND_MID;
         } else {
-            tex = botTex_;
+            kind = KIND_BOTTOM;
         }
 
         for (int c = 0; c < cols_; ++c) {
-            sf::Vector2f pos{ startPos_.x + c * spacingX_, startPos_.y + r * spacingY_ };
-            enemies_.emplace_back(tex, pos);
+            sf::Vector2f slot{ c * spacingX_, r * spacingY_ };
+            enemies_.emplace_back(slot, enemySize_, kind);
         }
     }
+
+    aliveBits_.assign((enemies_.size() + 63) / 64, 0);
+    for (size_t i = 0; i < enemies_.size(); ++i) aliveBits_[i >> 6] |= std::uint64_t{1} << (i & 63);
+    alive_ = static_cast<int>(enemies_.size());
+    colAlive_.assign(std::max(0, cols_), std::max(0, rows_));
+    rowAlive_.assign(std::max(0, rows_), std::max(0, cols_));
+    firstCol_ = 0;
+    lastCol_ = alive_ > 0 ? cols_ - 1 : -1;
+    lastRow_ = alive_ > 0 ? rows_ - 1 : -1;
+
+    lowestRow_.assign(std::max(0, cols_), alive_ > 0 ? rows_ - 1 : -1);
+    liveCols_.clear();
+    liveColPos_.assign(std::max(0, cols_), -1);
+    for (int c = 0; alive_ > 0 && c < cols_; ++c) {
+        liveColPos_[c] = static_cast<int>(liveCols_.size());
+        liveCols_.push_back(c);
+    }
+
+    divers_.clear();
+    origin_ = startPos_;
+    lastMove_ = { 0.f, 0.f };
     computeBounds();
 }
 
-void Formation::computeBounds() {
-    bool first = true;
-    float minx = 0.f, maxx = 0.f;
-    for (const auto &e : enemies_) {
-        if (!e.isActive()) continue;
-        auto b = e.bounds();
-        if (first) {
-            minx = b.position.x;
-            maxx = b.position.x + b.size.x;
-            first = false;
-        } else {
-            minx = std::min(minx, b.position.x);
-            maxx = std::max(maxx, b.position.x + b.size.x);
-        }
+void Formation::kill(int index) {
+    if (index < 0 || index >= static_cast<int>(enemies_.size()) || !isAlive(index)) return;
+    aliveBits_[index >> 6] &= ~(std::uint64_t{1} << (index & 63));
+    enemies_[index].setActive(false);
+    --alive_;
+    if (enemies_[index].isDiving()) {
+        auto it = std::find(divers_.begin(), divers_.end(), index);
+        *it = divers_.back();
+        divers_.pop_back();
     }
-    if (first) {
-        minX_ = maxX_ = 0.f;
-    } else {
-        minX_ = minx;
-        maxX_ = maxx;
+
+    int c = index % cols_;
+    int r = index / cols_;
+    // the column's shooter moves up past dead rows; each row is stepped over once per game
+    if (r == lowestRow_[c]) {
+        int up = r - 1;
+        while (up >= 0 && !isAlive(up * cols_ + c)) --up;
+        lowestRow_[c] = up;
     }
+    if (colAlive_[c] == 1) {
+        const int pos = liveColPos_[c];
+        liveColPos_[liveCols_.back()] = pos;
+        liveCols_[pos] = liveCols_.back();
+        liveCols_.pop_back();
+        liveColPos_[c] = -1;
+    }
+
+    // only an emptied edge column/row can change the extents
+    bool edgeChanged = false;
+    if (--colAlive_[c] == 0 && (c == firstCol_ || c == lastCol_)) edgeChanged = true;
+    if (--rowAlive_[r] == 0 && r == lastRow_) edgeChanged = true;
+    if (!edgeChanged) return;
+
+    while (firstCol_ <= lastCol_ && colAlive_[firstCol_] == 0) ++firstCol_;
+    while (lastCol_ >= firstCol_ && colAlive_[lastCol_] == 0) --lastCol_;
+    while (lastRow_ >= 0 && rowAlive_[lastRow_] == 0) --lastRow_;
+    computeBounds();
 }
 
-void Formation::update(float dt, float screenLeft, float screenRight) {
-    if (enemies_.empty()) return;
+void Formation::startDive(int index, const DivePath& path, bool mirror, float speed) {
+    if (index < 0 || index >= static_cast<int>(enemies_.size()) || !isAlive(index) || isDiving(index)) return;
+    enemies_[index].startDive(path, origin_ + enemies_[index].slot(), mirror, speed);
+    divers_.push_back(index);
+}
 
-    float moveX = dir_ * speed_ * dt;
-    for (auto &e : enemies_) {
-        if (e.isActive()) e.moveBy({ moveX, 0.f });
+sf::FloatRect Formation::enemyBounds(int index) const {
+    if (enemies_[index].isDiving()) return enemies_[index].worldBounds();
+    sf::FloatRect r = enemies_[index].localBounds();
+    r.position += origin_;
+    return r;
+}
+
+int Formation::sweepTest(const sf::FloatRect& box, const sf::Vector2f& move, float* toi, int* cellsTested) const {
+    if (alive_ == 0 || spacingX_ <= 0.f || spacingY_ <= 0.f) return -1;
+
+    int best = -1;
+    float bestT = 2.f;
+    // earliest contact wins; on a tie the lowest index, in both passes
+    auto consider = [&](int idx, float t) {
+        if (t < bestT || (t == bestT && idx < best)) { best = idx; bestT = t; }
+    };
+
+    // each diver moved on its own: sweep relative to it, from where it was at the start of the step
+    for (int idx : divers_) {
+        if (cellsTested) ++*cellsTested;
+        const Enemy& e = enemies_[idx];
+        const sf::Vector2f diverMove = e.position() - e.prevPosition();
+        float t;
+        if (sweepAabb(sf::FloatRect(box.position + diverMove, box.size), move - diverMove, e.worldBounds(), t)) consider(idx, t);
     }
 
-    computeBounds();
+    // the lattice in its own frame. Enemy (c,r) is centred on origin + (c*spacingX, r*spacingY),
+    // so solving for the index range under the swept box leaves only the cells the whole
+    // relative path can reach; a pixel of slack absorbs rounding in the division.
+    const sf::FloatRect rel(box.position + lastMove_, box.size);
+    const sf::Vector2f relMove = move - lastMove_;
+    const sf::FloatRect swept = sweptBounds(rel, relMove);
+    const float pad = 1.f;
+    const sf::Vector2f half = enemySize_ / 2.f;
+    auto firstIndex = [](float v, int n) { return static_cast<int>(std::ceil(std::clamp(v, -1.f, static_cast<float>(n)))); };
+    auto lastIndex = [](float v, int n) { return static_cast<int>(std::floor(std::clamp(v, -1.f, static_cast<float>(n)))); };
+    int c0 = std::max(0, firstIndex((swept.position.x - origin_.x - half.x - pad) / spacingX_, cols_));
+    int c1 = std::min(cols_ - 1, lastIndex((swept.position.x + swept.size.x - origin_.x + half.x + pad) / spacingX_, cols_));
+    int r0 = std::max(0, firstIndex((swept.position.y - origin_.y - half.y - pad) / spacingY_, rows_));
+    int r1 = std::min(rows_ - 1, lastIndex((swept.position.y + swept.size.y - origin_.y + half.y + pad) / spacingY_, rows_));
 
-    if (minX_ < screenLeft || maxX_ > screenRight) {
-        for (auto &e : enemies_) {
-            if (e.isActive()) e.moveBy({ -moveX, 0.f });
-        }
-        // invertir y aplicar drop
-        dir_ *= -1;
-        for (auto &e : enemies_) {
-            if (e.isActive()) e.moveBy({ 0.f, dropAmount_ });
+    for (int r = r0; r <= r1; ++r) {
+        for (int c = c0; c <= c1; ++c) {
+            int idx = r * cols_ + c;
+            if (cellsTested) ++*cellsTested;
+            float t;
+            if (isAlive(idx) && !isDiving(idx) && sweepAabb(rel, relMove, enemyBounds(idx), t)) consider(idx, t);
         }
-        // aumentar velocidad
-        speed_ *= 1.07f;
-        computeBounds();
     }
+    if (best >= 0 && toi) *toi = bestT;
+    return best;
 }
 
-void Formation::draw(sf::RenderWindow& window) const {
-    for (const auto &e : enemies_) {
-        if (e.isActive()) e.draw(window);
+void Formation::computeBounds() {
+    if (firstCol_ > lastCol_) {
+        minX_ = maxX_ = maxY_ = 0.f;
+        return;
     }
+    const sf::Vector2f half = enemySize_ / 2.f;
+    minX_ = static_cast<float>(firstCol_) * spacingX_ - half.x;
+    maxX_ = static_cast<float>(lastCol_) * spacingX_ + half.x;
+    maxY_ = static_cast<float>(lastRow_) * spacingY_ + half.y;
 }
 
-void Formation::reset() {
-    enemies_.clear();
-    int topCount = 1;
-    int midCount = 0;
-    if (rows_ > 1) {
-        midCount = std::max(1, (rows_ - topCount) / 2);
+void Formation::update(float dt, float screenLeft, float screenRight) {
+    if (alive_ == 0) { lastMove_ = { 0.f, 0.f }; return; }
+
+    float moveX = dir_ * speed_ * dt;
+    float nextX = origin_.x + moveX;
+    if (nextX + minX_ < screenLeft || nextX + maxX_ > screenRight) {
+        // invertir y aplicar drop
+        dir_ *= -1;
+        lastMove_ = { 0.f, dropAmount_ };
+        // aumentar velocidad
+        speed_ *= 1.07f;
+    } else {
+        lastMove_ = { moveX, 0.f };
     }
-    int botCount = rows_ - topCount - midCount;
-    if (botCount < 0) { botCount = 0; midCount = rows_ - topCount; }
+    origin_ += lastMove_;
 
-    for (int r = 0; r < rows_; ++r) {
-        const sf::Texture* tex = midTex_;
-        if (r < topCount) {
-            tex = topTex_;
-        } else if (r < topCount + midCount) {
-            tex = midTex_;
+    // divers home in on where their slot is now, so they land back in a moving grid
+    for (size_t k = 0; k < divers_.size();) {
+        const int idx = divers_[k];
+        if (enemies_[idx].update(dt, origin_ + enemies_[idx].slot(), diveExitY_)) {
+            divers_[k] = divers_.back();
+            divers_.pop_back();
         } else {
-            tex = botTex_;
-        }
-
-        for (int c = 0; c < cols_; ++c) {
-            sf::Vector2f pos{ startPos_.x + c * spacingX_, startPos_.y + r * spacingY_ };
-            enemies_.emplace_back(tex, pos);
+            ++k;
         }
     }
+}
 
+void Formation::reset() {
     dir_ = 1;
-    computeBounds();
+    populate();
 }
 
 int Formation::aliveCount() const {
-    int cnt = 0;
-    for (const auto &e : enemies_) if (e.isActive()) ++cnt;
-    return cnt;
-}
\ No newline at end of file
+    return alive_;
+}
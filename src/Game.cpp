@@ -1,12 +1,25 @@
 #include "Game.h"
 #include "Menu.h"
-#include "Formation.h"
-#include "Player.h"
-#include "Bullet.h"
-#include "Shield.h"
+#include "AssetLoader.h"
 #include <iostream>
 #include <string>
 #include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iterator>
+
+// shrinks a nominal hitbox to the image's aspect ratio (how the sprites were always scaled)
+static sf::Vector2f fitToImage(const sf::Vector2f& imageSize, const sf::Vector2f& box) {
+    if (imageSize.x <= 0.f || imageSize.y <= 0.f) return box;
+    float scale = std::min(box.x / imageSize.x, box.y / imageSize.y);
+    return imageSize * scale;
+}
+
+// rect drawn where it was `1 - alpha` of a step ago
+static sf::FloatRect interpolated(sf::FloatRect r, const sf::Vector2f& prev, const sf::Vector2f& cur, float alpha) {
+    r.position += (prev - cur) * (1.f - alpha);
+    return r;
+}
 
 Game::Game(unsigned int windowWidth, unsigned int windowHeight)
 : windowWidth_(windowWidth)
@@ -14,46 +27,140 @@ Game::Game(unsigned int windowWidth, unsigned int windowHeight)
 , window_(sf::VideoMode({ windowWidth_, windowHeight_ }), "Naves")
 , VIRTUAL_WIDTH_(windowWidth)
 , VIRTUAL_HEIGHT_(windowHeight)
-, rng_(static_cast<unsigned int>(std::random_device{}()))
 {
     window_.setVerticalSyncEnabled(true);
+    // controls come from press/release events; OS auto-repeat would only add duplicate presses
+    window_.setKeyRepeatEnabled(false);
     gameView_.setCenter(sf::Vector2f(static_cast<float>(VIRTUAL_WIDTH_)/2.f, static_cast<float>(VIRTUAL_HEIGHT_)/2.f));
     gameView_.setSize(sf::Vector2f(static_cast<float>(VIRTUAL_WIDTH_), static_cast<float>(VIRTUAL_HEIGHT_)));
-    playerStart_ = sf::Vector2f(MARGIN_.x + (WINDOW_COLS * CELL_SIZE) / 2.f,
-                                MARGIN_.y + HUD_HEIGHT + (WINDOW_ROWS * CELL_SIZE) - CELL_SIZE * 1.5f);
 }
 
 Game::~Game() {
+    // stopping the sim thread also saves a recording still in progress
+    if (sim_) sim_->stop();
     delete menu_;
     delete pauseMenu_;
 }
 
 bool Game::loadAssets() {
     bool ok = true;
-    hasFont_ = font_.openFromFile("assets/fonts/font.ttf");
+    sf::Clock decodeClock;
+
+    // one mapped archive next to the executable; loose files under assets/ are the fallback
+    if (pack_.open("assets.pak")) std::cout << "[INFO] assets: using assets.pak (" << pack_.entryCount() << " entries)\n";
+
+    // decode every image and sound on worker threads while this thread keeps the window alive;
+    // effects decoded on an earlier launch come back as raw PCM from cache/audio
+    PcmCache pcmCache("cache/audio");
+    AssetLoader loader;
+    loader.setPcmCache(&pcmCache);
+    auto queueImage = [&](const std::string& name) {
+        auto blob = pack_.find(name);
+        return blob.empty() ? loader.addImage("assets/" + name) : loader.addImage(blob, name);
+    };
+    auto queueSound = [&](const std::string& name) {
+        auto blob = pack_.find(name);
+        return blob.empty() ? loader.addSound("assets/" + name) : loader.addSound(blob, name);
+    };
+    struct SpriteFile { const char* file; int* id; int job; };
+    SpriteFile sprites[] = {
+        { "player.png", &sprPlayer_, -1 },
+        { "bullet.png", &sprBulletPlayer_, -1 },
+        { "bullet_2.png", &sprBulletEnemy_, -1 },
+        { "alien_top.png", &sprAlienTop_, -1 },
+        { "alien_mid.png", &sprAlienMid_, -1 },
+        { "alien_bottom.png", &sprAlienBot_, -1 },
+    };
+    for (auto &s : sprites) s.job = queueImage(std::string("textures/") + s.file);
+    const int laserJob = queueSound("sounds/laser_sound.mp3");
+    const int explosionJob = queueSound("sounds/explosion_enemy.mp3");
+    const int bossExplosionJob = queueSound("sounds/explosion_boss.mp3");
+    const int soundJobs[] = { laserJob, explosionJob, bossExplosionJob };
+    const int backgroundJob = queueImage("textures/background.png");
+    loader.start();
+
+    // fonts stream glyphs from their source, so the blob has to stay mapped (pack_ outlives font_)
+    auto fontBlob = pack_.find("fonts/font.ttf");
+    hasFont_ = fontBlob.empty() ? font_.openFromFile("assets/fonts/font.ttf") : font_.openFromMemory(fontBlob.data(), fontBlob.size());
     if (!hasFont_) { std::cerr << "[WARN] could not load font\n"; ok = false; }
-    if (!texPlayer_.loadFromFile("assets/textures/player.png")) { std::cerr << "[WARN] could not load player.png\n"; ok = false; }
-    if (!texBulletPlayer_.loadFromFile("assets/textures/bullet.png")) { std::cerr << "[WARN] could not load bullet.png\n"; ok = false; }
-    if (!texBulletEnemy_.loadFromFile("assets/textures/bullet_2.png")) { std::cerr << "[WARN] could not load bullet_2.png\n"; ok = false; }
-    if (!texAlienTop_.loadFromFile("assets/textures/alien_top.png")) { std::cerr << "[WARN] could not load alien_top.png\n"; ok = false; }
-    if (!texAlienMid_.loadFromFile("assets/textures/alien_mid.png")) { std::cerr << "[WARN] could not load alien_mid.png\n"; ok = false; }
-    if (!texAlienBot_.loadFromFile("assets/textures/alien_bottom.png")) { std::cerr << "[WARN] could not load alien_bottom.png\n"; ok = false; }
-    if (!texShield_.loadFromFile("assets/textures/shield.png")) { std::cerr << "[WARN] could not load shield.png\n"; ok = false; }
 
-    if (laserBuf_.loadFromFile("assets/sounds/laser_sound.mp3")) laserSound_.emplace(laserBuf_);
-    else std::cerr << "[WARN] could not load laser_sound.mp3\n";
+    while (!loader.done() && window_.isOpen()) {
+        while (auto evOpt = window_.pollEvent()) {
+            if (evOpt->is<sf::Event::Closed>()) window_.close();
+            else if (auto r = evOpt->getIf<sf::Event::Resized>()) updateGameViewForWindow(r->size.x, r->size.y);
+        }
+        renderLoading(static_cast<float>(loader.completed()) / static_cast<float>(loader.total()));
+    }
+    loader.wait();
+    const float decodeMs = static_cast<float>(decodeClock.getElapsedTime().asMicroseconds()) / 1000.f;
+
+    // GPU upload happens here, on the main thread
+    for (auto &s : sprites) {
+        auto img = loader.takeImage(s.job);
+        if (!img) { std::cerr << "[WARN] could not load " << s.file << "\n"; ok = false; continue; }
+        *s.id = atlas_.add(std::move(*img));
+    }
+    if (!atlas_.build()) { std::cerr << "[WARN] could not build sprite atlas\n"; ok = false; }
+    if (auto img = loader.takeImage(backgroundJob)) hasBackground_ = bgTexture_.loadFromImage(*img);
+    if (hasBackground_) bgTexture_.setSmooth(true);
+    else std::cerr << "[WARN] could not load background.png\n";
+
+    // priorities: the wave-clear boom beats kills, kills beat the (very frequent) laser
+    struct SoundFile { int job; int* id; int priority; };
+    const SoundFile soundFiles[] = {
+        { laserJob, &sndLaser_, 1 },
+        { explosionJob, &sndExplosion_, 2 },
+        { bossExplosionJob, &sndBossExplosion_, 3 },
+    };
+    for (const auto &f : soundFiles) {
+        if (auto buf = loader.takeSound(f.job)) *f.id = voices_.addSound(std::move(*buf), f.priority);
+        else std::cerr << "[WARN] could not load " << loader.path(f.job) << "\n";
+    }
 
-    explosionLoaded_ = explosionBuf_.loadFromFile("assets/sounds/explosion_enemy.mp3");
-    if (!explosionLoaded_) std::cerr << "[WARN] could not load explosion_enemy.mp3\n";
+    // summed per-job time (jobs overlap across threads); compare a cold launch with a warm one
+    int cachedSounds = 0;
+    float soundMs = 0.f;
+    for (int job : soundJobs) {
+        cachedSounds += loader.fromCache(job) ? 1 : 0;
+        soundMs += loader.loadMs(job);
+    }
+    std::cout << "[INFO] audio: " << std::size(soundJobs) << " effects in " << soundMs << " ms ("
+              << cachedSounds << " from PCM cache, " << std::size(soundJobs) - cachedSounds << " decoded)\n";
 
+    const float totalMs = static_cast<float>(decodeClock.getElapsedTime().asMicroseconds()) / 1000.f;
+    std::cout << "[INFO] assets: decoded in " << decodeMs << " ms on " << loader.threadCount()
+              << " threads, ready (incl. upload) in " << totalMs << " ms\n";
     return ok;
 }
 
+void Game::renderLoading(float progress) {
+    window_.setView(window_.getDefaultView());
+    window_.clear(sf::Color(8,8,12));
+    sf::Vector2f win(static_cast<float>(window_.getSize().x), static_cast<float>(window_.getSize().y));
+    sf::Vector2f barSize{ win.x * 0.5f, 12.f };
+    sf::Vector2f barPos{ (win.x - barSize.x) * 0.5f, (win.y - barSize.y) * 0.5f };
+
+    sf::RectangleShape frame(barSize);
+    frame.setPosition(barPos);
+    frame.setFillColor(sf::Color(40,40,50));
+    frame.setOutlineColor(sf::Color(200,200,200));
+    frame.setOutlineThickness(2.f);
+    window_.draw(frame);
+
+    sf::RectangleShape fill({ barSize.x * std::clamp(progress, 0.f, 1.f), barSize.y });
+    fill.setPosition(barPos);
+    fill.setFillColor(sf::Color(230,230,230));
+    window_.draw(fill);
+    window_.display();
+}
+
 bool Game::init() {
-    if (!loadAssets()) std::cerr << "Continuing in degraded mode\n";
     createView();
+    if (!loadAssets()) std::cerr << "Continuing in degraded mode\n";
 
-    if (bgMusic_.openFromFile("assets/music/bg_music.ogg")) { bgMusic_.setLooping(true); bgMusic_.play(); musicOn_ = true; }
+    auto musicBlob = pack_.find("music/bg_music.ogg");
+    bool musicOpen = musicBlob.empty() ? bgMusic_.openFromFile("assets/music/bg_music.ogg") : bgMusic_.openFromMemory(musicBlob.data(), musicBlob.size());
+    if (musicOpen) { bgMusic_.setLooping(true); bgMusic_.play(); musicOn_ = true; }
 
     menu_ = new Menu(hasFont_ ? &font_ : nullptr, 80);
     menu_->setOptions({ "NEW GAME", "EXIT" }, { static_cast<float>(VIRTUAL_WIDTH_) / 2.f, static_cast<float>(VIRTUAL_HEIGHT_) / 2.f }, 140.f);
@@ -79,35 +186,30 @@ bool Game::init() {
         musicIcon_->setPosition(sf::Vector2f(bpos.x + bsize.x * 0.5f, bpos.y + bsize.y * 0.5f));
     }
 
-    bullets_.reserve(64);
-    for (size_t i = 0; i < 64; ++i) bullets_.emplace_back(texBulletPlayer_.getSize().x ? &texBulletPlayer_ : nullptr);
-    enemyBullets_.reserve(32);
-    for (size_t i = 0; i < 32; ++i) enemyBullets_.emplace_back(texBulletEnemy_.getSize().x ? &texBulletEnemy_ : nullptr);
-
     if (hasFont_) {
-        scoreText_.emplace(font_, "Score: 0", 28);
-        scoreText_->setFillColor(sf::Color::White);
-        livesText_.emplace(font_, "Lives: 3", 28);
-        livesText_->setFillColor(sf::Color::White);
-        overlayTitle_.emplace(font_, "", 64);
-        overlayTitle_->setFillColor(sf::Color::White);
-        overlaySub_.emplace(font_, "", 28);
-        overlaySub_->setFillColor(sf::Color(200,200,200));
-    }
-
-    player_ = std::make_unique<Player>(texPlayer_.getSize().x ? &texPlayer_ : nullptr, playerStart_);
-    formation_ = createFormation();
-
-    // prepare explosion sounds pool
-    explosionSounds_.clear();
-    if (explosionLoaded_) {
-        const size_t POOL_SIZE = 8;
-        explosionSounds_.reserve(POOL_SIZE);
-        for (size_t i = 0; i < POOL_SIZE; ++i) explosionSounds_.emplace_back(explosionBuf_);
-        explosionSoundIndex_ = 0;
+        scoreHud_.emplace(font_, 28, "Score: ");
+        livesHud_.emplace(font_, 28, "Lives: ");
     }
+    menuBackdrop_.emplace(sf::Color(8,8,12));
+    pauseOverlay_.emplace(sf::Color(0,0,0,200));
+    resultOverlay_.emplace(sf::Color(0,0,0,200), hasFont_ ? &font_ : nullptr);
+
+    // hitboxes follow the loaded textures; all alien textures are square so one fit covers them
+    simConfig_.playerSize = fitToImage(atlas_.texRect(sprPlayer_).size, simConfig_.playerSize);
+    simConfig_.enemySize = fitToImage(atlas_.texRect(sprAlienTop_).size, simConfig_.enemySize);
+    simConfig_.playerBulletSize = fitToImage(atlas_.texRect(sprBulletPlayer_).size, simConfig_.playerBulletSize);
+    simConfig_.enemyBulletSize = fitToImage(atlas_.texRect(sprBulletEnemy_).size, simConfig_.enemyBulletSize);
+    sim_ = std::make_unique<SimThread>(simConfig_, simStep_);
+    if (!recordPath_.empty() && !replaying_) sim_->recordTo(recordPath_);
+    if (replaying_) sim_->playReplay(replay_, fastForward_);
+    sim_->start();
+    if (profiling_) sim_->setProfiling(true);
+
+    // without render textures the static content is simply drawn every frame
+    if (!staticLayer_.create({ VIRTUAL_WIDTH_, VIRTUAL_HEIGHT_ })) std::cerr << "[WARN] no static layer, drawing shields every frame\n";
 
     resetGameState();
+    if (replaying_) state_ = AppState::Playing;
     return true;
 }
 
@@ -129,80 +231,213 @@ void Game::updateGameViewForWindow(unsigned int winW, unsigned int winH) {
     gameView_.setViewport(sf::FloatRect({vpL, vpT}, {vpW, vpH}));
 }
 
-std::unique_ptr<Formation> Game::createFormation() {
-    const float formationStartX = MARGIN_.x + 2.f * CELL_SIZE;
-    const float formationStartY = MARGIN_.y + HUD_HEIGHT + 1.f * CELL_SIZE;
-    const float spacingX = static_cast<float>(CELL_SIZE) * 1.65f;
-    const float spacingY = static_cast<float>(CELL_SIZE) * 1.15f;
-    return std::make_unique<Formation>(
-        texAlienTop_.getSize().x ? &texAlienTop_ : nullptr,
-        texAlienMid_.getSize().x ? &texAlienMid_ : nullptr,
-        texAlienBot_.getSize().x ? &texAlienBot_ : nullptr,
-        ENEMY_COLS, ENEMY_ROWS,
-        sf::Vector2f{ formationStartX, formationStartY },
-        spacingX, spacingY,
-        40.f, 18.f
-    );
-}
-
+// the sim thread picks the seed and restarts any recording; HUD and shields follow once its
+// first snapshot of the new game arrives (syncSnapshot)
 void Game::resetGameState() {
-    player_->setPosition(playerStart_);
-    formation_ = createFormation();
-    for (auto &b : bullets_) b.deactivate();
-    for (auto &b : enemyBullets_) b.deactivate();
-    shields_.clear();
+    sim_->reset();
+    ++game_;
     pausedForResult_ = false;
     paused_ = false;
-    score_ = 0;
-    lives_ = 3;
-    if (scoreText_) scoreText_->setString("Score: 0");
-    if (livesText_) livesText_->setString("Lives: 3");
-
-    float shieldsY = player_->bounds().position.y - 120.f;
-    sf::Vector2f desiredSize{ 140.f, 70.f };
-    float padding = 48.f;
-    float available = static_cast<float>(VIRTUAL_WIDTH_) - 2.f * padding;
-    float totalW = 4.f * desiredSize.x;
-    float gapBetween = 0.f;
-    if (available > totalW) gapBetween = (available - totalW) / 3.f + desiredSize.x;
-    else gapBetween = desiredSize.x + 12.f;
-    float firstCenterX = padding + desiredSize.x * 0.5f;
-    for (int i = 0; i < 4; ++i) {
-        float centerX = firstCenterX + static_cast<float>(i) * gapBetween;
-        if (texShield_.getSize().x) shields_.emplace_back(&texShield_, sf::Vector2f{ centerX - desiredSize.x / 2.f, shieldsY }, SHIELD_HP, desiredSize);
+}
+
+// score and lives sit to the right of the music button, vertically centred on it
+void Game::layoutHud() {
+    const sf::Vector2f btnPos = musicBtn_.getPosition();
+    const sf::Vector2f btnSize = musicBtn_.getSize();
+    const float paddingX = 12.f;
+    const float spacing = 12.f;
+    const float centerY = btnPos.y + btnSize.y * 0.5f;
+    float x = btnPos.x + btnSize.x + paddingX;
+    for (auto* hud : { &scoreHud_, &livesHud_ }) {
+        if (!*hud) continue;
+        (*hud)->setOrigin({ 0.f, ((*hud)->top() + (*hud)->bottom()) * 0.5f });
+        (*hud)->setPosition({ x, centerY });
+        x += (*hud)->width() + spacing;
     }
+}
 
-    shootTimer_ = 0.f;
-    enemyShootTimer_ = enemyShootDist_(rng_);
-}
-
-bool Game::trySpawnFromColumn(int col) {
-    if (!formation_) return false;
-    auto &en = formation_->enemies();
-    for (int r = ENEMY_ROWS - 1; r >= 0; --r) {
-        int idx = r * ENEMY_COLS + col;
-        if (idx < 0 || idx >= static_cast<int>(en.size())) continue;
-        auto &enemy = en[idx];
-        if (enemy.isActive()) {
-            sf::FloatRect eb = enemy.bounds();
-            sf::Vector2f shotPos{ eb.position.x + eb.size.x / 2.f, eb.position.y + eb.size.y + 4.f };
-            for (auto &b : enemyBullets_) {
-                if (!b.isActive()) {
-                    b.spawn(shotPos, 220.f);
-                    return true;
-                }
-            }
-            return false;
+// stamped as the event is pulled off the queue and sent to the sim thread at once, instead of
+// sampling the keyboard once per frame (which loses taps shorter than a frame)
+void Game::onKey(sf::Keyboard::Key key, bool down) {
+    static const sf::Keyboard::Key KEYS[INPUT_KEYS] = {
+        sf::Keyboard::Key::Left, sf::Keyboard::Key::A, sf::Keyboard::Key::Right, sf::Keyboard::Key::D, sf::Keyboard::Key::Space,
+    };
+    static const InputBuffer::Control CONTROLS[INPUT_KEYS] = {
+        InputBuffer::Control::Left, InputBuffer::Control::Left, InputBuffer::Control::Right, InputBuffer::Control::Right, InputBuffer::Control::Fire,
+    };
+    const auto it = std::find(std::begin(KEYS), std::end(KEYS), key);
+    if (it == std::end(KEYS)) return;
+    const size_t k = static_cast<size_t>(it - std::begin(KEYS));
+    if (keyDown_[k] == down) return;
+    keyDown_[k] = down;
+
+    const InputBuffer::Control control = CONTROLS[k];
+    bool any = false;
+    for (int i = 0; i < INPUT_KEYS; ++i) any = any || (keyDown_[i] && CONTROLS[i] == control);
+    bool& state = controlDown_[static_cast<int>(control)];
+    if (state == any) return;
+    state = any;
+    if (sim_) sim_->sendKey({ control, any, std::chrono::steady_clock::now() });
+}
+
+// focus loss swallows the key-up events, so treat it as letting go of everything
+void Game::releaseAllKeys() {
+    for (auto key : { sf::Keyboard::Key::Left, sf::Keyboard::Key::A, sf::Keyboard::Key::Right, sf::Keyboard::Key::D, sf::Keyboard::Key::Space })
+        onKey(key, false);
+}
+
+void Game::setPaused(bool paused) {
+    paused_ = paused;
+    if (state_ == AppState::Playing && !pausedForResult_) sim_->setMode(paused ? SimThread::Mode::Paused : SimThread::Mode::Running);
+}
+
+// turns what the sim thread did since the last frame into sounds, HUD values and shield uploads
+void Game::syncSnapshot() {
+    sim_->acquire();
+    const RenderSnapshot& snap = sim_->snapshot();
+    if (snap.game != game_) return; // still the previous game; the reset hasn't been seen yet
+
+    if (syncedGame_ != game_) {
+        syncedGame_ = game_;
+        seen_ = SimEvents{};
+        replayDoneSeen_ = false;
+        if (scoreHud_) scoreHud_->setValue(snap.score);
+        if (livesHud_) livesHud_->setValue(snap.lives);
+        layoutHud();
+        rebuildShieldTextures();
+        staticLayer_.invalidate(StaticLayer::Shields);
+    }
+
+    // triggers only; voices_.flush() starts them once per frame
+    if (snap.shotsFired > seen_.shotsFired) voices_.play(sndLaser_);
+    if (snap.enemiesKilled > seen_.enemiesKilled) {
+        voices_.play(sndExplosion_);
+        if (scoreHud_) {
+            const float oldWidth = scoreHud_->width();
+            scoreHud_->setValue(snap.score);
+            if (scoreHud_->width() != oldWidth) layoutHud(); // lives follows the score
+        }
+    }
+    if (snap.playerHits > seen_.playerHits && livesHud_) livesHud_->setValue(snap.lives);
+    if (snap.shieldHits > seen_.shieldHits) {
+        uploadChangedShieldRows();
+        staticLayer_.invalidate(StaticLayer::Shields);
+    }
+    seen_.shotsFired = snap.shotsFired;
+    seen_.enemiesKilled = snap.enemiesKilled;
+    seen_.playerHits = snap.playerHits;
+    seen_.shieldHits = snap.shieldHits;
+
+    if (!pausedForResult_ && snap.status == SimStatus::Lost) showResult("GAME OVER", sf::Color::Red);
+    else if (!pausedForResult_ && snap.status == SimStatus::Won) {
+        voices_.play(sndBossExplosion_);
+        showResult("YOU WIN", sf::Color::Yellow);
+    }
+    if (snap.replayFinished && !replayDoneSeen_) {
+        replayDoneSeen_ = true;
+        replaying_ = false;
+        // a recording that ended mid-game (quit to menu) ends the same way here
+        if (!pausedForResult_) { state_ = AppState::Menu; sim_->setMode(SimThread::Mode::Idle); }
+    }
+}
+
+// how far the wall clock is past the newest snapshot's tick, in ticks
+float Game::interpolationAlpha() const {
+    const float since = std::chrono::duration<float>(std::chrono::steady_clock::now() - sim_->snapshot().tickTime).count();
+    return std::clamp(since / simStep_, 0.f, 1.f);
+}
+
+void Game::showResult(const std::string& title, sf::Color color) {
+    pausedForResult_ = true;
+    if (resultOverlay_) resultOverlay_->setText(title, color, "Press ENTER to restart");
+}
+
+// colour of the bunker art (shield.png); the shape itself comes from the sim's mask
+static const sf::Color SHIELD_COLOR(35,177,77);
+
+void Game::rebuildShieldTextures() {
+    const auto& shields = sim_->snapshot().shields;
+    shieldTextures_.resize(shields.size());
+    shieldMasks_.resize(shields.size());
+    for (size_t i = 0; i < shields.size(); ++i) {
+        shieldMasks_[i] = shields[i].mask;
+        const sf::Vector2u size(static_cast<unsigned int>(shields[i].width), static_cast<unsigned int>(shields[i].height));
+        if (shieldTextures_[i].getSize() != size && !shieldTextures_[i].resize(size)) continue;
+        uploadShieldRows(i, 0, shields[i].height);
+    }
+}
+
+// the snapshot carries whole masks (it may stand for several ticks), so the rows to re-upload
+// are found by comparing against what was uploaded last
+void Game::uploadChangedShieldRows() {
+    const auto& shields = sim_->snapshot().shields;
+    for (size_t i = 0; i < shields.size() && i < shieldMasks_.size(); ++i) {
+        const RenderSnapshot::ShieldView& s = shields[i];
+        std::vector<std::uint64_t>& uploaded = shieldMasks_[i];
+        if (uploaded.size() != s.mask.size()) continue;
+        const size_t words = static_cast<size_t>(s.wordsPerRow);
+        int begin = s.height, end = 0;
+        for (int y = 0; y < s.height; ++y) {
+            const auto first = uploaded.begin() + static_cast<std::ptrdiff_t>(y * words);
+            if (std::equal(first, first + static_cast<std::ptrdiff_t>(words), s.row(y))) continue;
+            begin = std::min(begin, y);
+            end = y + 1;
+        }
+        if (begin >= end) continue;
+        std::copy(s.mask.begin(), s.mask.end(), uploaded.begin());
+        uploadShieldRows(i, begin, end);
+    }
+}
+
+void Game::uploadShieldRows(size_t shield, int begin, int end) {
+    const RenderSnapshot::ShieldView& s = sim_->snapshot().shields[shield];
+    if (begin >= end || shield >= shieldTextures_.size() || shieldTextures_[shield].getSize().x != static_cast<unsigned int>(s.width)) return;
+    const int w = s.width;
+    shieldPixels_.resize(static_cast<size_t>(w) * (end - begin) * 4);
+    std::uint8_t* px = shieldPixels_.data();
+    for (int y = begin; y < end; ++y) {
+        for (int x = 0; x < w; ++x, px += 4) {
+            const bool solid = s.solidAt(x, y);
+            px[0] = SHIELD_COLOR.r;
+            px[1] = SHIELD_COLOR.g;
+            px[2] = SHIELD_COLOR.b;
+            px[3] = solid ? 255 : 0;
         }
     }
-    return false;
+    shieldTextures_[shield].update(shieldPixels_.data(), { static_cast<unsigned int>(w), static_cast<unsigned int>(end - begin) }, { 0u, static_cast<unsigned int>(begin) });
 }
 
-bool Game::rectsIntersect(const sf::FloatRect& a, const sf::FloatRect& b) {
-    return !(a.position.x + a.size.x < b.position.x ||
-             b.position.x + b.size.x < a.position.x ||
-             a.position.y + a.size.y < b.position.y ||
-             b.position.y + b.size.y < a.position.y);
+void Game::queueShields() {
+    const auto& shields = sim_->snapshot().shields;
+    for (size_t i = 0; i < shields.size(); ++i) {
+        if (shields[i].solidCount <= 0) continue;
+        // without a texture the shield degrades to its box
+        if (i < shieldTextures_.size() && shieldTextures_[i].getSize().x > 0) batch_.add(&shieldTextures_[i], shields[i].bounds);
+        else batch_.add(nullptr, shields[i].bounds, SHIELD_COLOR);
+    }
+}
+
+void Game::paintStaticLayer(sf::RenderTarget& target) {
+    const sf::Vector2f field(static_cast<float>(VIRTUAL_WIDTH_), static_cast<float>(VIRTUAL_HEIGHT_));
+    if (hasBackground_) {
+        // cover the field, keeping the aspect ratio (same fit as the menu background)
+        const sf::Vector2f ts(bgTexture_.getSize());
+        const float scale = std::max(field.x / ts.x, field.y / ts.y);
+        const sf::Vector2f size = ts * scale;
+        batch_.add(&bgTexture_, sf::FloatRect((field - size) * 0.5f, size));
+    }
+    queueShields();
+    // HUD frame: a band behind score/lives with a rule along its bottom edge
+    const float hudBottom = simConfig_.margin.y + simConfig_.hudHeight;
+    batch_.add(nullptr, sf::FloatRect({ 0.f, 0.f }, { field.x, hudBottom }), sf::Color(10,10,18,200));
+    batch_.add(nullptr, sf::FloatRect({ 0.f, hudBottom - 2.f }, { field.x, 2.f }), sf::Color(60,60,80));
+    batch_.flush(target);
+}
+
+void Game::drawBox(int sprite, const sf::FloatRect& rect, sf::Color fallback, sf::Color tint) {
+    // queued into batch_; nothing reaches the window until batch_.flush()
+    if (!atlas_.valid(sprite)) batch_.add(nullptr, rect, fallback);
+    else batch_.add(atlas_.texture(sprite), rect, atlas_.texRect(sprite), tint);
 }
 
 void Game::handleEvents() {
@@ -215,10 +450,16 @@ void Game::handleEvents() {
             if (r) updateGameViewForWindow(static_cast<unsigned int>(r->size.x), static_cast<unsigned int>(r->size.y));
         }
 
+        if (ev.is<sf::Event::FocusLost>()) releaseAllKeys();
+        if (auto up = ev.getIf<sf::Event::KeyReleased>()) onKey(up->code, false);
+
         if (ev.is<sf::Event::KeyPressed>()) {
             auto k = ev.getIf<sf::Event::KeyPressed>();
             if (!k) continue;
-            if (k->code == sf::Keyboard::Key::Escape && !pausedForResult_) paused_ = !paused_;
+            onKey(k->code, true);
+            if (k->code == sf::Keyboard::Key::F3) setProfiling(!profiling_);
+            if (k->code == sf::Keyboard::Key::F4 && profiling_) writeTrace();
+            if (k->code == sf::Keyboard::Key::Escape && !pausedForResult_) setPaused(!paused_);
             if (pausedForResult_) {
                 if (k->code == sf::Keyboard::Key::Enter || k->code == sf::Keyboard::Key::Space) resetGameState();
             }
@@ -253,23 +494,24 @@ void Game::handleEvents() {
                 pauseMenu_->processEvent(ev, window_);
                 if (pauseMenu_->consumeConfirm()) {
                     int sel = pauseMenu_->getSelectedIndex();
-                    if (sel == 0) paused_ = false;
-                    else if (sel == 1) { resetGameState(); state_ = AppState::Playing; paused_ = false; }
-                    else if (sel == 2) { paused_ = false; state_ = AppState::Menu; }
+                    if (sel == 0) setPaused(false);
+                    else if (sel == 1) { resetGameState(); state_ = AppState::Playing; }
+                    else if (sel == 2) { sim_->setMode(SimThread::Mode::Idle); paused_ = false; state_ = AppState::Menu; }
                 }
             }
             window_.setView(prev);
             continue;
         }
 
-        // no further in-game event handling needed here (realtime input handled in update)
+        // no further in-game event handling needed here (controls went out through onKey)
     }
 }
 
-void Game::update(float dt) {
+// once per frame; the simulation itself steps on the sim thread
+void Game::update(float frameTime) {
     if (state_ == AppState::Menu) {
         if (menu_) {
-            menu_->update(dt);
+            menu_->update(frameTime);
             if (menu_->consumeConfirm()) {
                 int sel = menu_->getSelectedIndex();
                 if (sel == 0) { resetGameState(); state_ = AppState::Playing; }
@@ -279,104 +521,8 @@ void Game::update(float dt) {
         return;
     }
 
-    if (paused_ || pausedForResult_) return;
-
-    shootTimer_ -= dt; if (shootTimer_ < 0.f) shootTimer_ = 0.f;
-
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Left) || sf::Keyboard::isKeyPressed(sf::Keyboard::Key::A)) player_->moveLeft(dt);
-    else if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Right) || sf::Keyboard::isKeyPressed(sf::Keyboard::Key::D)) player_->moveRight(dt);
-
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Space) && shootTimer_ <= 0.f) {
-        sf::FloatRect pb = player_->bounds();
-        sf::Vector2f bulletPos{ pb.position.x + pb.size.x / 2.f, pb.position.y - 6.f };
-        for (auto &b : bullets_) {
-            if (!b.isActive()) { b.spawn(bulletPos, -480.f); if (laserSound_) laserSound_->play(); shootTimer_ = SHOOT_COOLDOWN; break; }
-        }
-    }
-
-    player_->update(dt);
-    for (auto &b : bullets_) b.update(dt);
-    for (auto &b : enemyBullets_) b.update(dt);
-    if (formation_) formation_->update(dt, MARGIN_.x, static_cast<float>(VIRTUAL_WIDTH_) - MARGIN_.x);
-
-    enemyShootTimer_ -= dt;
-    if (enemyShootTimer_ <= 0.f) {
-        int tries = ENEMY_COLS; bool spawned = false;
-        while (tries-- > 0 && !spawned) {
-            int col = enemyColDist_(rng_);
-            spawned = trySpawnFromColumn(col);
-        }
-        enemyShootTimer_ = enemyShootDist_(rng_);
-    }
-
-    for (auto &b : bullets_) {
-        if (!b.isActive()) continue;
-        bool hitShield = false;
-        for (auto &s : shields_) {
-            if (!s.isActive()) continue;
-            if (rectsIntersect(s.bounds(), b.bounds())) { b.deactivate(); hitShield = true; break; }
-        }
-        if (hitShield) continue;
-        for (auto &e : formation_->enemies()) {
-            if (!e.isActive()) continue;
-            if (rectsIntersect(b.bounds(), e.bounds())) {
-                b.deactivate();
-                e.setActive(false);
-
-                // play explosion sound
-                if (explosionLoaded_ && !explosionSounds_.empty()) {
-                    explosionSounds_[explosionSoundIndex_].setBuffer(explosionBuf_);
-                    explosionSounds_[explosionSoundIndex_].play();
-                    explosionSoundIndex_ = (explosionSoundIndex_ + 1) % explosionSounds_.size();
-                }
-
-                score_ += 10;
-                if (scoreText_) scoreText_->setString("Score: " + std::to_string(score_));
-                break;
-            }
-        }
-    }
-
-    for (auto &b : enemyBullets_) {
-        if (!b.isActive()) continue;
-        bool hitShield = false;
-        for (auto &s : shields_) {
-            if (!s.isActive()) continue;
-            if (rectsIntersect(s.bounds(), b.bounds())) { b.deactivate(); s.takeDamage(1); hitShield = true; break; }
-        }
-        if (hitShield) continue;
-        if (rectsIntersect(b.bounds(), player_->bounds())) {
-            b.deactivate();
-            lives_ -= 1;
-            if (livesText_) livesText_->setString("Lives: " + std::to_string(lives_));
-            if (lives_ <= 0) {
-                pausedForResult_ = true;
-                if (overlayTitle_) { overlayTitle_->setString("GAME OVER"); overlayTitle_->setFillColor(sf::Color::Red); }
-                if (overlaySub_) overlaySub_->setString("Press ENTER to restart");
-            } else {
-                player_->setPosition(playerStart_);
-            }
-        }
-    }
-
-    for (auto &e : formation_->enemies()) {
-        if (!e.isActive()) continue;
-        sf::FloatRect eb = e.bounds();
-        if (eb.position.y + eb.size.y >= playerStart_.y - CELL_SIZE * 0.5f) {
-            pausedForResult_ = true;
-            if (overlayTitle_) { overlayTitle_->setString("GAME OVER"); overlayTitle_->setFillColor(sf::Color::Red); }
-            if (overlaySub_) overlaySub_->setString("Press ENTER to restart");
-            break;
-        }
-    }
-
-    bool anyAlive = false;
-    for (auto &e : formation_->enemies()) { if (e.isActive()) { anyAlive = true; break; } }
-    if (!anyAlive) {
-        pausedForResult_ = true;
-        if (overlayTitle_) { overlayTitle_->setString("YOU WIN"); overlayTitle_->setFillColor(sf::Color::Yellow); }
-        if (overlaySub_) overlaySub_->setString("Press ENTER to restart");
-    }
+    // input already went out from handleEvents as it arrived
+    syncSnapshot();
 
     // music handling: pause/resume depending on menu visibility
     bool menuVisible = (state_ == AppState::Menu) || (state_ == AppState::Playing && (paused_ || pausedForResult_));
@@ -393,131 +539,203 @@ void Game::update(float dt) {
     }
 }
 
-void Game::render() {
+void Game::render(float alpha) {
     window_.clear(sf::Color(18,18,28));
 
     if (state_ == AppState::Menu) {
         window_.setView(window_.getDefaultView());
-        sf::RectangleShape fullBg(sf::Vector2f(static_cast<float>(window_.getSize().x), static_cast<float>(window_.getSize().y)));
-        fullBg.setFillColor(sf::Color(8,8,12));
-        window_.draw(fullBg);
+        if (menuBackdrop_) menuBackdrop_->draw(window_);
         if (menu_) menu_->draw(window_);
+        if (profiling_) drawFrameGraph();
         window_.display();
         return;
     }
 
-    // If a menu is visible (pause or end-game), draw only default-view overlay as in original main
+    // pause or end-game: only the default-view overlay, as in the original main
     if (paused_ || pausedForResult_) {
         window_.setView(window_.getDefaultView());
-        sf::RectangleShape fullBg(sf::Vector2f(static_cast<float>(window_.getSize().x), static_cast<float>(window_.getSize().y)));
-        fullBg.setFillColor(sf::Color(0,0,0,200));
-        window_.draw(fullBg);
-
-        if (paused_ && !pausedForResult_) {
-            if (pauseMenu_) pauseMenu_->draw(window_);
-        }
-
         if (pausedForResult_) {
-            if (hasFont_ && overlayTitle_ && overlaySub_) {
-                sf::Vector2u cur = window_.getSize();
-                sf::FloatRect rt = overlayTitle_->getLocalBounds();
-                float ox = rt.position.x + rt.size.x * 0.5f;
-                float oy = rt.position.y + rt.size.y * 0.5f;
-                overlayTitle_->setOrigin(sf::Vector2f(ox, oy));
-                overlayTitle_->setPosition(sf::Vector2f(static_cast<float>(cur.x)/2.f, static_cast<float>(cur.y)/2.f - 24.f));
-
-                sf::FloatRect rs = overlaySub_->getLocalBounds();
-                float sox = rs.position.x + rs.size.x * 0.5f;
-                float soy = rs.position.y + rs.size.y * 0.5f;
-                overlaySub_->setOrigin(sf::Vector2f(sox, soy));
-                overlaySub_->setPosition(sf::Vector2f(static_cast<float>(cur.x)/2.f, static_cast<float>(cur.y)/2.f + 40.f));
-
-                window_.draw(*overlayTitle_);
-                window_.draw(*overlaySub_);
-            }
+            if (resultOverlay_) resultOverlay_->draw(window_);
+        } else {
+            if (pauseOverlay_) pauseOverlay_->draw(window_);
+            if (pauseMenu_) pauseMenu_->draw(window_);
         }
-
+        if (profiling_) drawFrameGraph();
         window_.display();
         return;
     }
 
-    // Normal gameplay rendering
+    // Normal gameplay rendering; static content is one cached quad unless a layer changed
     window_.setView(gameView_);
-    for (auto &s : shields_) s.draw(window_);
-    if (formation_) formation_->draw(window_);
-    for (auto &b : bullets_) if (b.isActive()) b.draw(window_);
-    for (auto &b : enemyBullets_) if (b.isActive()) b.draw(window_);
-    if (player_) player_->draw(window_);
+    staticLayer_.refresh([this](sf::RenderTarget& target) { paintStaticLayer(target); });
+    if (staticLayer_.valid()) batch_.add(&staticLayer_.texture(), staticLayer_.rect());
+    else queueShields();
+
+    // the whole grid shares one origin, so interpolating it moves every enemy
+    const RenderSnapshot& snap = sim_->snapshot();
+    const sf::Vector2f formationOrigin = snap.formationOrigin - snap.formationMove * (1.f - alpha);
+    const int alienSprite[] = { sprAlienTop_, sprAlienMid_, sprAlienBot_ };
+    for (const auto &e : snap.enemies) {
+        sf::FloatRect r = e.bounds;
+        if (e.diving) r = interpolated(r, e.prev, e.pos, alpha);
+        else r.position += formationOrigin;
+        drawBox(alienSprite[e.kind], r, sf::Color(200,80,80));
+    }
+
+    for (const auto &b : snap.shots) drawBox(sprBulletPlayer_, interpolated(b.bounds, b.prev, b.pos, alpha), sf::Color::Yellow);
+    for (const auto &b : snap.enemyShots) drawBox(sprBulletEnemy_, interpolated(b.bounds, b.prev, b.pos, alpha), sf::Color::Yellow);
+
+    const RenderSnapshot::Box& player = snap.player;
+    drawBox(sprPlayer_, interpolated(player.bounds, player.prev, player.pos, alpha), sf::Color::White);
+    batch_.flush(window_);
 
     window_.setView(window_.getDefaultView());
-    sf::Vector2u curSize = window_.getSize();
 
     // Draw music button + icon
     window_.draw(musicBtn_);
     if (musicIcon_) window_.draw(*musicIcon_);
 
-    // Draw score and lives to the right of music button
-    {
-        sf::Vector2f btnPos = musicBtn_.getPosition();
-        sf::Vector2f btnSize = musicBtn_.getSize();
-        const float paddingX = 12.f;
-        const float spacing = 12.f;
-        const float startX = btnPos.x + btnSize.x + paddingX;
-        const float centerY = btnPos.y + btnSize.y * 0.5f;
-
-        if (scoreText_) {
-            sf::FloatRect tb = scoreText_->getLocalBounds();
-            scoreText_->setOrigin(sf::Vector2f(0.f, tb.position.y + tb.size.y * 0.5f));
-            scoreText_->setPosition(sf::Vector2f(startX, centerY));
-            window_.draw(*scoreText_);
-        }
+    if (scoreHud_) window_.draw(*scoreHud_);
+    if (livesHud_) window_.draw(*livesHud_);
+    if (profiling_) drawFrameGraph();
+
+    window_.display();
+}
+
+void Game::setSimulationRate(float hz) {
+    if (hz > 0.f) simStep_ = 1.f / hz;
+}
+
+void Game::setProfiling(bool on) {
+    profiling_ = on;
+    Profiler::setCurrent(on ? &profiler_ : nullptr);
+    if (sim_) sim_->setProfiling(on);
+}
+
+// main thread and sim thread side by side (tids 1 and 2) on one timeline
+void Game::writeTrace() {
+    bool ok = false;
+    if (sim_) sim_->withProfiler([&](const Profiler& simProfiler) {
+        ok = Profiler::writeChromeTrace("galaga_trace.json", { { &profiler_, "main" }, { &simProfiler, "sim" } });
+    });
+    else ok = profiler_.writeChromeTrace("galaga_trace.json");
+    if (ok) std::cout << "[INFO] profiler: wrote galaga_trace.json\n";
+    else std::cerr << "[WARN] could not write galaga_trace.json\n";
+}
+
+// last Profiler::FRAME_HISTORY frames as stacked bars (one colour per top-level phase, grey for
+// untracked time) in the bottom-left corner, with the 60 Hz budget as a white line. The sim
+// thread's ticks go above it on their own scale, against the fixed step.
+void Game::drawFrameGraph() {
+    const float baseY = window_.getDefaultView().getSize().y - 12.f;
+    frameGraph_.clear();
+    appendFrameGraph(profiler_, baseY, 34.f, 1000.f / 60.f, graphLegend_);
+    if (sim_) sim_->withProfiler([&](const Profiler& simProfiler) {
+        appendFrameGraph(simProfiler, baseY - 160.f, 2.f, simStep_ * 1000.f, simGraphLegend_);
+    });
+    window_.draw(frameGraph_);
+    for (const auto &t : graphLegend_) window_.draw(t);
+    for (const auto &t : simGraphLegend_) window_.draw(t);
+}
 
-        float nextX = startX;
-        if (scoreText_) nextX += scoreText_->getGlobalBounds().size.x + spacing;
-        if (livesText_) {
-            sf::FloatRect tb2 = livesText_->getLocalBounds();
-            livesText_->setOrigin(sf::Vector2f(0.f, tb2.position.y + tb2.size.y * 0.5f));
-            livesText_->setPosition(sf::Vector2f(nextX, centerY));
-            window_.draw(*livesText_);
+// one graph, 136 px tall for rangeMs (taller bars are clipped); the budget line only if in range
+void Game::appendFrameGraph(const Profiler& profiler, float baseY, float rangeMs, float budgetMs, std::vector<sf::Text>& legend) {
+    static const sf::Color PALETTE[Profiler::MAX_PHASES] = {
+        sf::Color(90,160,255), sf::Color(255,170,60), sf::Color(120,220,120), sf::Color(230,90,90),
+        sf::Color(200,120,230), sf::Color(240,230,90), sf::Color(90,220,220), sf::Color(250,150,190),
+        sf::Color(160,200,90), sf::Color(255,120,40), sf::Color(140,140,255), sf::Color(200,170,130),
+    };
+    const float barW = 2.f;
+    const float height = 136.f;
+    const float pxPerMs = height / rangeMs;
+    const float left = 12.f;
+    const float width = barW * static_cast<float>(Profiler::FRAME_HISTORY);
+
+    auto quad = [this](float x0, float y0, float x1, float y1, sf::Color c) {
+        frameGraph_.append({ { x0, y0 }, c, {} });
+        frameGraph_.append({ { x1, y0 }, c, {} });
+        frameGraph_.append({ { x0, y1 }, c, {} });
+        frameGraph_.append({ { x0, y1 }, c, {} });
+        frameGraph_.append({ { x1, y0 }, c, {} });
+        frameGraph_.append({ { x1, y1 }, c, {} });
+    };
+    quad(left - 4.f, baseY - height, left + width + 4.f, baseY + 4.f, sf::Color(0,0,0,160));
+
+    const float top = baseY - height;
+    const size_t phases = profiler.phaseNames().size();
+    for (size_t i = 0; i < profiler.frameCount(); ++i) {
+        const Profiler::Frame& f = profiler.frame(i);
+        const float x = left + static_cast<float>(i) * barW;
+        float y = baseY;
+        float tracked = 0.f;
+        for (size_t p = 0; p < phases && y > top; ++p) {
+            const float h = std::min(f.phaseMs[p] * pxPerMs, y - top);
+            quad(x, y - h, x + barW, y, PALETTE[p]);
+            y -= h;
+            tracked += f.phaseMs[p];
         }
+        const float rest = std::min(std::max(0.f, f.totalMs - tracked) * pxPerMs, y - top);
+        quad(x, y - rest, x + barW, y, sf::Color(120,120,120));
     }
-
-    // Pause overlay/menu if needed (draw above HUD)
-    if (paused_ && !pausedForResult_) {
-        sf::RectangleShape overlay(sf::Vector2f(static_cast<float>(curSize.x), static_cast<float>(curSize.y)));
-        overlay.setFillColor(sf::Color(0,0,0,160));
-        window_.draw(overlay);
-        if (pauseMenu_) pauseMenu_->draw(window_);
+    if (budgetMs <= rangeMs) {
+        const float budgetY = baseY - budgetMs * pxPerMs;
+        quad(left - 4.f, budgetY, left + width + 4.f, budgetY + 1.f, sf::Color(255,255,255,180));
     }
 
-    if (pausedForResult_) {
-        sf::RectangleShape overlay(sf::Vector2f(static_cast<float>(curSize.x), static_cast<float>(curSize.y)));
-        overlay.setFillColor(sf::Color(0,0,0,160));
-        window_.draw(overlay);
-        if (overlayTitle_ && overlaySub_) {
-            sf::FloatRect rt = overlayTitle_->getLocalBounds();
-            float ox = rt.position.x + rt.size.x * 0.5f;
-            float oy = rt.position.y + rt.size.y * 0.5f;
-            overlayTitle_->setOrigin(sf::Vector2f(ox, oy));
-            overlayTitle_->setPosition(sf::Vector2f(static_cast<float>(curSize.x)/2.f, static_cast<float>(curSize.y)/2.f - 24.f));
-            sf::FloatRect rs = overlaySub_->getLocalBounds();
-            float sox = rs.position.x + rs.size.x * 0.5f;
-            float soy = rs.position.y + rs.size.y * 0.5f;
-            overlaySub_->setOrigin(sf::Vector2f(sox, soy));
-            overlaySub_->setPosition(sf::Vector2f(static_cast<float>(curSize.x)/2.f, static_cast<float>(curSize.y)/2.f + 40.f));
-            window_.draw(*overlayTitle_);
-            window_.draw(*overlaySub_);
-        }
+    // legend texts are created once, when their phase first shows up
+    if (!hasFont_) return;
+    for (size_t p = legend.size(); p < phases; ++p) {
+        sf::Text t(font_, profiler.phaseNames()[p], 14);
+        t.setFillColor(PALETTE[p]);
+        legend.push_back(std::move(t));
     }
+    for (size_t p = 0; p < legend.size(); ++p) legend[p].setPosition({ left + width + 12.f, baseY - 16.f * static_cast<float>(p + 1) });
+}
 
-    window_.display();
+void Game::recordTo(const std::string& path) {
+    recordPath_ = path;
+}
+
+bool Game::playReplay(const std::string& path, bool fastForward) {
+    if (!replay_.load(path)) {
+        std::cerr << "[ERROR] could not read replay " << path << ": " << replay_.error() << "\n";
+        return false;
+    }
+    // the recorded step is part of the input; a different rate would not reproduce the game
+    simStep_ = replay_.step();
+    replaying_ = true;
+    fastForward_ = fastForward;
+    return true;
 }
 
 void Game::run() {
+    clock_.restart();
     while (window_.isOpen()) {
-        handleEvents();
-        float dt = clock_.restart().asSeconds();
-        update(dt);
-        render();
+        if (profiling_) profiler_.beginFrame();
+        {
+            PROFILE_SCOPE("events");
+            handleEvents();
+        }
+        {
+            // input out, newest snapshot in; never waits on the sim thread
+            PROFILE_SCOPE("update");
+            update(clock_.restart().asSeconds());
+        }
+        {
+            PROFILE_SCOPE("audio");
+            voices_.flush();
+        }
+        {
+            PROFILE_SCOPE("render");
+            render(interpolationAlpha());
+        }
+        if (profiling_) profiler_.endFrame();
+
+        if (!firstFrameShown_) {
+            firstFrameShown_ = true;
+            std::cout << "[INFO] first interactive frame after "
+                      << static_cast<float>(startupClock_.getElapsedTime().asMicroseconds()) / 1000.f << " ms\n";
+        }
     }
-}
\ No newline at end of file
+    if (profiling_) writeTrace();
+}
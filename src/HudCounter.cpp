@@ -0,0 +1,91 @@
+#include "HudCounter.h"
+#include <algorithm>
+
+HudCounter::HudCounter(const sf::Font& font, unsigned int characterSize, std::string_view label, sf::Color color)
+: font_(&font)
+, characterSize_(characterSize)
+, color_(color)
+{
+    const float baseline = static_cast<float>(characterSize_);
+    top_ = baseline;
+    bottom_ = baseline;
+    auto extend = [&](const sf::Glyph& g) {
+        if (g.bounds.size.y <= 0.f) return;
+        top_ = std::min(top_, baseline + g.bounds.position.y);
+        bottom_ = std::max(bottom_, baseline + g.bounds.position.y + g.bounds.size.y);
+    };
+
+    vertices_.resize((label.size() + MAX_DIGITS) * 6);
+    float x = 0.f;
+    char prev = 0;
+    for (char c : label) {
+        if (prev) x += font_->getKerning(static_cast<unsigned char>(prev), static_cast<unsigned char>(c), characterSize_);
+        const sf::Glyph& g = font_->getGlyph(static_cast<unsigned char>(c), characterSize_, false);
+        writeGlyph(labelVertices_, g, x);
+        labelVertices_ += 6;
+        x += g.advance;
+        extend(g);
+        prev = c;
+    }
+    for (int d = 0; d < 10; ++d) {
+        digitGlyphs_[d] = font_->getGlyph(static_cast<std::uint32_t>('0' + d), characterSize_, false);
+        extend(digitGlyphs_[d]);
+    }
+    digitX_[0] = x;
+    setValue(0);
+}
+
+void HudCounter::setValue(int value) {
+    value = std::max(value, 0);
+    if (value == value_) return;
+    value_ = value;
+
+    std::array<std::uint8_t, MAX_DIGITS> next{};
+    int count = 0;
+    do {
+        next[count++] = static_cast<std::uint8_t>(value % 10);
+        value /= 10;
+    } while (value > 0 && count < MAX_DIGITS);
+    std::reverse(next.begin(), next.begin() + count);
+
+    // digits before the first change keep their quads and pen positions
+    int first = 0;
+    while (first < count && first < digitCount_ && next[first] == digits_[first]) ++first;
+    for (int i = first; i < count; ++i) {
+        digits_[i] = next[i];
+        const sf::Glyph& g = digitGlyphs_[next[i]];
+        writeGlyph(labelVertices_ + static_cast<size_t>(i) * 6, g, digitX_[i]);
+        digitX_[i + 1] = digitX_[i] + g.advance;
+    }
+    digitCount_ = count;
+}
+
+void HudCounter::writeGlyph(size_t firstVertex, const sf::Glyph& glyph, float x) {
+    // same 1px padding sf::Text uses, so filtering at the edges matches
+    const float padding = 1.f;
+    const float baseline = static_cast<float>(characterSize_);
+    const float left = x + glyph.bounds.position.x - padding;
+    const float top = baseline + glyph.bounds.position.y - padding;
+    const float right = x + glyph.bounds.position.x + glyph.bounds.size.x + padding;
+    const float bottom = baseline + glyph.bounds.position.y + glyph.bounds.size.y + padding;
+
+    const float u1 = static_cast<float>(glyph.textureRect.position.x) - padding;
+    const float v1 = static_cast<float>(glyph.textureRect.position.y) - padding;
+    const float u2 = static_cast<float>(glyph.textureRect.position.x + glyph.textureRect.size.x) + padding;
+    const float v2 = static_cast<float>(glyph.textureRect.position.y + glyph.textureRect.size.y) + padding;
+
+    sf::Vertex* v = &vertices_[firstVertex];
+    v[0] = { { left, top }, color_, { u1, v1 } };
+    v[1] = { { right, top }, color_, { u2, v1 } };
+    v[2] = { { left, bottom }, color_, { u1, v2 } };
+    v[3] = { { left, bottom }, color_, { u1, v2 } };
+    v[4] = { { right, top }, color_, { u2, v1 } };
+    v[5] = { { right, bottom }, color_, { u2, v2 } };
+}
+
+void HudCounter::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+    states.transform *= getTransform();
+    // the page texture object is stable even when the font grows it for new glyphs
+    states.texture = &font_->getTexture(characterSize_);
+    target.draw(vertices_.data(), labelVertices_ + static_cast<size_t>(digitCount_) * 6, sf::PrimitiveType::Triangles, states);
+}
@@ -0,0 +1,59 @@
+#include "InputBuffer.h"
+#include <algorithm>
+
+SimInput InputBuffer::consume(Clock::time_point tickTime) {
+    std::fill(std::begin(tapped_), std::end(tapped_), false);
+    firePress_.reset();
+    for (; next_ < pending_.size() && pending_[next_].time <= tickTime; ++next_) {
+        const KeyEvent& e = pending_[next_];
+        const int c = static_cast<int>(e.control);
+        if (e.down && !held_[c]) {
+            tapped_[c] = true;
+            if (e.control == Control::Fire && !firePress_) firePress_ = e.time;
+        }
+        held_[c] = e.down;
+    }
+    // everything consumed: reuse the storage instead of growing it
+    if (next_ == pending_.size()) { pending_.clear(); next_ = 0; }
+
+    const int left = static_cast<int>(Control::Left);
+    const int right = static_cast<int>(Control::Right);
+    const int fire = static_cast<int>(Control::Fire);
+    SimInput in;
+    in.left = held_[left] || tapped_[left];
+    in.right = held_[right] || tapped_[right];
+    in.fire = held_[fire] || tapped_[fire];
+    return in;
+}
+
+void InputBuffer::clearTaps() {
+    // apply the transitions so held_ stays right, but forget that anything was pressed
+    consume(Clock::time_point::max());
+    std::fill(std::begin(tapped_), std::end(tapped_), false);
+    firePress_.reset();
+}
+
+void LatencyStats::add(float ms) {
+    if (samples_.size() < SAMPLES) samples_.push_back(ms);
+    else samples_[head_] = ms;
+    head_ = (head_ + 1) % SAMPLES;
+    ++count_;
+    sumMs_ += ms;
+    maxMs_ = std::max(maxMs_, ms);
+}
+
+void LatencyStats::clear() {
+    samples_.clear();
+    head_ = 0;
+    count_ = 0;
+    sumMs_ = 0.0;
+    maxMs_ = 0.f;
+}
+
+float LatencyStats::percentileMs(float p) const {
+    if (samples_.empty()) return 0.f;
+    std::vector<float> sorted(samples_);
+    const size_t k = static_cast<size_t>(std::clamp(p, 0.f, 1.f) * static_cast<float>(sorted.size() - 1));
+    std::nth_element(sorted.begin(), sorted.begin() + static_cast<std::ptrdiff_t>(k), sorted.end());
+    return sorted[k];
+}
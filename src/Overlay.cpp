@@ -0,0 +1,42 @@
+#include "Overlay.h"
+
+Overlay::Overlay(sf::Color backdrop, const sf::Font* font, unsigned int titleSize, unsigned int subtitleSize) {
+    backdrop_.setFillColor(backdrop);
+    if (font) {
+        title_.emplace(*font, "", titleSize);
+        title_->setFillColor(sf::Color::White);
+        subtitle_.emplace(*font, "", subtitleSize);
+        subtitle_->setFillColor(sf::Color(200,200,200));
+    }
+}
+
+void Overlay::setText(const std::string& title, sf::Color titleColor, const std::string& subtitle) {
+    if (!title_ || !subtitle_) return;
+    title_->setString(title);
+    title_->setFillColor(titleColor);
+    subtitle_->setString(subtitle);
+    dirty_ = true;
+}
+
+void Overlay::draw(sf::RenderTarget& target) {
+    const sf::Vector2u size = target.getSize();
+    if (dirty_ || size != laidOutFor_) layout(size);
+    target.draw(backdrop_);
+    if (title_ && !title_->getString().isEmpty()) target.draw(*title_);
+    if (subtitle_ && !subtitle_->getString().isEmpty()) target.draw(*subtitle_);
+}
+
+void Overlay::layout(sf::Vector2u size) {
+    const sf::Vector2f s(static_cast<float>(size.x), static_cast<float>(size.y));
+    backdrop_.setSize(s);
+    if (title_ && subtitle_) {
+        sf::FloatRect rt = title_->getLocalBounds();
+        title_->setOrigin(sf::Vector2f(rt.position.x + rt.size.x * 0.5f, rt.position.y + rt.size.y * 0.5f));
+        title_->setPosition(sf::Vector2f(s.x / 2.f, s.y / 2.f - 24.f));
+        sf::FloatRect rs = subtitle_->getLocalBounds();
+        subtitle_->setOrigin(sf::Vector2f(rs.position.x + rs.size.x * 0.5f, rs.position.y + rs.size.y * 0.5f));
+        subtitle_->setPosition(sf::Vector2f(s.x / 2.f, s.y / 2.f + 40.f));
+    }
+    laidOutFor_ = size;
+    dirty_ = false;
+}
@@ -0,0 +1,108 @@
+#include "PcmCache.h"
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+static constexpr char PCM_MAGIC[4] = { 'G', 'P', 'C', 'M' };
+static constexpr std::uint32_t PCM_VERSION = 1;
+
+template <typename T>
+static bool readLE(std::istream& in, T& v) {
+    unsigned char buf[sizeof(T)];
+    if (!in.read(reinterpret_cast<char*>(buf), sizeof(T))) return false;
+    v = 0;
+    for (size_t i = 0; i < sizeof(T); ++i) v |= static_cast<T>(buf[i]) << (8 * i);
+    return true;
+}
+
+template <typename T>
+static void writeLE(std::ostream& out, T v) {
+    char buf[sizeof(T)];
+    for (size_t i = 0; i < sizeof(T); ++i) buf[i] = static_cast<char>((v >> (8 * i)) & 0xFF);
+    out.write(buf, sizeof(T));
+}
+
+PcmCache::PcmCache(std::filesystem::path dir)
+: dir_(std::move(dir))
+{}
+
+std::uint64_t PcmCache::hash(std::span<const std::byte> data) {
+    std::uint64_t h = 14695981039346656037ull;
+    for (std::byte b : data) {
+        h ^= std::to_integer<std::uint8_t>(b);
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+std::filesystem::path PcmCache::fileFor(const std::string& name) const {
+    // "sounds/laser_sound.mp3" and "assets/sounds/laser_sound.mp3" share "<dir>/laser_sound.pcm"
+    return dir_ / std::filesystem::path(name).filename().replace_extension(".pcm");
+}
+
+PcmCache::Result PcmCache::load(const std::string& name, std::span<const std::byte> source, sf::SoundBuffer& out) const {
+    const std::uint64_t sourceHash = hash(source);
+    const auto file = fileFor(name);
+    if (read(file, sourceHash, out)) return Result::Hit;
+
+    if (!out.loadFromMemory(source.data(), source.size())) return Result::Failed;
+    if (!write(file, sourceHash, out)) std::cerr << "[WARN] could not write PCM cache " << file.string() << "\n";
+    return Result::Decoded;
+}
+
+bool PcmCache::read(const std::filesystem::path& file, std::uint64_t sourceHash, sf::SoundBuffer& out) const {
+    std::ifstream in(file, std::ios::binary);
+    if (!in) return false;
+
+    char magic[4];
+    std::uint32_t version = 0, sampleRate = 0, channelCount = 0;
+    std::uint64_t storedHash = 0, sampleCount = 0;
+    if (!in.read(magic, 4) || std::string_view(magic, 4) != std::string_view(PCM_MAGIC, 4)) return false;
+    if (!readLE(in, version) || version != PCM_VERSION) return false;
+    if (!readLE(in, storedHash) || storedHash != sourceHash) return false;
+    if (!readLE(in, sampleRate) || !readLE(in, channelCount) || channelCount == 0 || channelCount > 32) return false;
+
+    std::vector<sf::SoundChannel> channelMap(channelCount);
+    for (auto &ch : channelMap) {
+        std::uint8_t raw = 0;
+        if (!readLE(in, raw)) return false;
+        ch = static_cast<sf::SoundChannel>(raw);
+    }
+    if (!readLE(in, sampleCount)) return false;
+
+    // a damaged count must not size the buffer: it has to match the bytes left in the file
+    const std::streampos body = in.tellg();
+    if (body < 0 || !in.seekg(0, std::ios::end)) return false;
+    const std::streamoff remaining = in.tellg() - body;
+    if (remaining < 0 || sampleCount > static_cast<std::uint64_t>(remaining) / sizeof(std::int16_t)) return false;
+    if (sampleCount * sizeof(std::int16_t) != static_cast<std::uint64_t>(remaining) || !in.seekg(body)) return false;
+
+    std::vector<std::int16_t> samples(static_cast<size_t>(sampleCount));
+    if (!in.read(reinterpret_cast<char*>(samples.data()), static_cast<std::streamsize>(sampleCount * sizeof(std::int16_t)))) return false;
+    return out.loadFromSamples(samples.data(), sampleCount, channelCount, sampleRate, channelMap);
+}
+
+bool PcmCache::write(const std::filesystem::path& file, std::uint64_t sourceHash, const sf::SoundBuffer& buf) const {
+    std::error_code ec;
+    std::filesystem::create_directories(file.parent_path(), ec);
+
+    // write to a temp name and rename, so a crash never leaves a truncated entry behind
+    auto tmp = file;
+    tmp += ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+        const auto channelMap = buf.getChannelMap();
+        out.write(PCM_MAGIC, 4);
+        writeLE<std::uint32_t>(out, PCM_VERSION);
+        writeLE<std::uint64_t>(out, sourceHash);
+        writeLE<std::uint32_t>(out, buf.getSampleRate());
+        writeLE<std::uint32_t>(out, static_cast<std::uint32_t>(channelMap.size()));
+        for (auto ch : channelMap) writeLE<std::uint8_t>(out, static_cast<std::uint8_t>(ch));
+        writeLE<std::uint64_t>(out, buf.getSampleCount());
+        out.write(reinterpret_cast<const char*>(buf.getSamples()), static_cast<std::streamsize>(buf.getSampleCount() * sizeof(std::int16_t)));
+        if (!out) return false;
+    }
+    std::filesystem::rename(tmp, file, ec);
+    return !ec;
+}
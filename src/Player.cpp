@@ -1,35 +1,13 @@
 #include "Player.h"
-#include <memory>
 
-static constexpr float TARGET_PLAYER_W = 50.f; // ancho
-static constexpr float TARGET_PLAYER_H = 50.f; // alto
-
-Player::Player(const sf::Texture* texture, const sf::Vector2f& startPos)
-    : position_(startPos)
+Player::Player(const sf::Vector2f& startPos, const sf::Vector2f& size)
+    : position_(startPos), prevPosition_(startPos), lastUpdatePos_(startPos), size_(size)
 {
-    if (texture) {
-        sprite_ = std::make_unique<sf::Sprite>(*texture);
-        auto local = sprite_->getLocalBounds();
-
-        float scaleX = TARGET_PLAYER_W / local.size.x;
-        float scaleY = TARGET_PLAYER_H / local.size.y;
-        float scale = std::min(scaleX, scaleY);
-        sprite_->setScale({ scale, scale });
-
-        auto newLocal = sprite_->getLocalBounds();
-        sprite_->setOrigin({ newLocal.size.x / 2.f, newLocal.size.y / 2.f });
-        sprite_->setPosition(position_);
-    }
 }
 
 void Player::update(float /*dt*/) {
-    if (sprite_) sprite_->setPosition(position_);
-    else fallbackRect_.setPosition(position_);
-}
-
-void Player::draw(sf::RenderWindow& window) const {
-    if (sprite_) window.draw(*sprite_);
-    else window.draw(fallbackRect_);
+    prevPosition_ = lastUpdatePos_;
+    lastUpdatePos_ = position_;
 }
 
 void Player::moveLeft(float dt) {
@@ -39,13 +17,12 @@ void Player::moveLeft(float dt) {
 
 void Player::setPosition(const sf::Vector2f& pos) {
     position_ = pos;
-    if (sprite_) sprite_->setPosition(position_);
-    else fallbackRect_.setPosition(position_);
+    prevPosition_ = pos;
+    lastUpdatePos_ = pos;
 }
 
 sf::FloatRect Player::bounds() const {
-    if (sprite_) return sprite_->getGlobalBounds();
-    return fallbackRect_.getGlobalBounds();
+    return sf::FloatRect{ position_ - size_ / 2.f, size_ };
 }
 void Player::setHorizontalLimits(float left, float right) {
     leftLimit_ = left;
@@ -55,12 +32,6 @@ void Player::setHorizontalLimits(float left, float right) {
 
 void Player::moveRight(float dt) {
     position_.x += speed_ * dt;
-    float halfW = 3.f;
-    if (sprite_) {
-        auto gb = sprite_->getGlobalBounds();
-        halfW = gb.size.x / 3.f;
-    } else {
-        halfW = fallbackRect_.getSize().x / 3.f;
-    }
+    float halfW = size_.x / 3.f;
     if (position_.x > rightLimit_ - halfW) position_.x = rightLimit_ - halfW;
-}
\ No newline at end of file
+}
@@ -0,0 +1,86 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+thread_local Profiler* Profiler::current_ = nullptr;
+
+Profiler::Clock::time_point Profiler::processEpoch() {
+    static const Clock::time_point epoch = Clock::now();
+    return epoch;
+}
+
+Profiler::Profiler(size_t eventCapacity)
+: epoch_(processEpoch())
+, events_(std::max<size_t>(eventCapacity, 1))
+{
+    stack_.reserve(32);
+    phaseNames_.reserve(MAX_PHASES);
+}
+
+void Profiler::beginFrame() {
+    open_ = Frame{};
+    frameStartNs_ = now();
+    inFrame_ = true;
+}
+
+void Profiler::endFrame() {
+    if (!inFrame_) return;
+    open_.totalMs = static_cast<float>(now() - frameStartNs_) / 1e6f;
+    frames_[frameHead_] = open_;
+    frameHead_ = (frameHead_ + 1) % FRAME_HISTORY;
+    if (frameCount_ < FRAME_HISTORY) ++frameCount_;
+    inFrame_ = false;
+}
+
+void Profiler::beginScope(const char* name) {
+    stack_.push_back(Open{ name, now() });
+}
+
+void Profiler::endScope() {
+    if (stack_.empty()) return;
+    const Open open = stack_.back();
+    stack_.pop_back();
+    const std::int64_t dur = now() - open.startNs;
+    const int depth = static_cast<int>(stack_.size());
+
+    events_[eventHead_] = Event{ open.name, open.startNs, dur, depth };
+    eventHead_ = (eventHead_ + 1) % events_.size();
+    if (eventCount_ < events_.size()) ++eventCount_;
+
+    // a phase may run several times per frame (update per sim step), so it accumulates
+    if (inFrame_ && depth == 0) {
+        const size_t idx = phaseIndex(open.name);
+        if (idx < MAX_PHASES) open_.phaseMs[idx] += static_cast<float>(dur) / 1e6f;
+    }
+}
+
+size_t Profiler::phaseIndex(const char* name) {
+    for (size_t i = 0; i < phaseNames_.size(); ++i) {
+        if (phaseNames_[i] == name || std::strcmp(phaseNames_[i], name) == 0) return i;
+    }
+    if (phaseNames_.size() >= MAX_PHASES) return MAX_PHASES;
+    phaseNames_.push_back(name);
+    return phaseNames_.size() - 1;
+}
+
+bool Profiler::writeChromeTrace(const std::string& path, const std::vector<TraceThread>& threads) {
+    std::ofstream out(path);
+    if (!out) return false;
+    // complete ("X") events, microsecond timestamps; nesting comes from the times
+    out << "{\"traceEvents\":[\n";
+    for (size_t t = 0; t < threads.size(); ++t) {
+        const Profiler& p = *threads[t].profiler;
+        const size_t tid = t + 1;
+        out << (t ? ",\n" : "") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << tid
+            << ",\"args\":{\"name\":\"" << threads[t].name << "\"}}";
+        const size_t head = (p.eventHead_ + p.events_.size() - p.eventCount_) % p.events_.size();
+        for (size_t i = 0; i < p.eventCount_; ++i) {
+            const Event& e = p.events_[(head + i) % p.events_.size()];
+            out << ",\n{\"name\":\"" << e.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << tid << ",\"ts\":"
+                << static_cast<double>(e.startNs) / 1000.0 << ",\"dur\":" << static_cast<double>(e.durNs) / 1000.0 << "}";
+        }
+    }
+    out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    return static_cast<bool>(out);
+}
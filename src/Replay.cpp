@@ -0,0 +1,91 @@
+#include "Replay.h"
+#include <bit>
+#include <fstream>
+
+static constexpr char REPLAY_MAGIC[4] = { 'G', 'R', 'P', 'L' };
+// bump whenever the simulation changes what the same inputs produce
+// (2: swept collision, 3: one-pick shooter selection + dive attacks)
+static constexpr std::uint32_t REPLAY_VERSION = 3;
+
+template <typename T>
+static void writeLE(std::ostream& out, T v) {
+    char buf[sizeof(T)];
+    for (size_t i = 0; i < sizeof(T); ++i) buf[i] = static_cast<char>((v >> (8 * i)) & 0xFF);
+    out.write(buf, sizeof(T));
+}
+
+template <typename T>
+static bool readLE(std::istream& in, T& v) {
+    unsigned char buf[sizeof(T)];
+    if (!in.read(reinterpret_cast<char*>(buf), sizeof(T))) return false;
+    v = 0;
+    for (size_t i = 0; i < sizeof(T); ++i) v |= static_cast<T>(buf[i]) << (8 * i);
+    return true;
+}
+
+std::uint8_t Replay::pack(const SimInput& input, bool paused) {
+    std::uint8_t bits = 0;
+    if (input.left) bits |= Left;
+    if (input.right) bits |= Right;
+    if (input.fire) bits |= Fire;
+    if (paused) bits |= Pause;
+    return bits;
+}
+
+SimInput Replay::unpack(std::uint8_t bits) {
+    SimInput in;
+    in.left = (bits & Left) != 0;
+    in.right = (bits & Right) != 0;
+    in.fire = (bits & Fire) != 0;
+    return in;
+}
+
+void Replay::begin(std::uint32_t seed, float step) {
+    seed_ = seed;
+    step_ = step;
+    finalChecksum_ = 0;
+    ticks_.clear();
+}
+
+bool Replay::save(const std::string& path) const {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+    out.write(REPLAY_MAGIC, 4);
+    writeLE<std::uint32_t>(out, REPLAY_VERSION);
+    writeLE<std::uint32_t>(out, seed_);
+    writeLE<std::uint32_t>(out, std::bit_cast<std::uint32_t>(step_));
+    writeLE<std::uint64_t>(out, finalChecksum_);
+    writeLE<std::uint64_t>(out, ticks_.size());
+    out.write(reinterpret_cast<const char*>(ticks_.data()), static_cast<std::streamsize>(ticks_.size()));
+    return static_cast<bool>(out);
+}
+
+bool Replay::load(const std::string& path) {
+    error_.clear();
+    std::ifstream in(path, std::ios::binary);
+    if (!in) { error_ = "cannot open file"; return false; }
+    char magic[4];
+    std::uint32_t version = 0, seed = 0, stepBits = 0;
+    std::uint64_t checksum = 0, count = 0;
+    if (!in.read(magic, 4) || std::string(magic, 4) != std::string(REPLAY_MAGIC, 4)) { error_ = "not a replay file"; return false; }
+    if (!readLE(in, version)) { error_ = "truncated header"; return false; }
+    if (version != REPLAY_VERSION) {
+        error_ = "recorded by simulation version " + std::to_string(version) + ", this build plays version " + std::to_string(REPLAY_VERSION);
+        return false;
+    }
+    if (!readLE(in, seed) || !readLE(in, stepBits) || !readLE(in, checksum) || !readLE(in, count)) { error_ = "truncated header"; return false; }
+
+    // a corrupt count must not size the buffer: it can't claim more ticks than the file holds
+    const std::streampos body = in.tellg();
+    if (body < 0 || !in.seekg(0, std::ios::end)) { error_ = "unreadable file"; return false; }
+    const std::streamoff remaining = in.tellg() - body;
+    if (remaining < 0 || count > static_cast<std::uint64_t>(remaining) || !in.seekg(body)) { error_ = "truncated tick data"; return false; }
+
+    std::vector<std::uint8_t> ticks(static_cast<size_t>(count));
+    if (!in.read(reinterpret_cast<char*>(ticks.data()), static_cast<std::streamsize>(count))) { error_ = "truncated tick data"; return false; }
+    seed_ = seed;
+    step_ = std::bit_cast<float>(stepBits);
+    finalChecksum_ = checksum;
+    ticks_ = std::move(ticks);
+    return true;
+}
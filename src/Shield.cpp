@@ -1,48 +1,111 @@
 #include "Shield.h"
 #include <algorithm>
-#include <cstdint>
-
-Shield::Shield(const sf::Texture* tex, const sf::Vector2f& position, int hp, const sf::Vector2f& size)
-: tex_(tex), hp_(hp), maxHp_(hp), active_(hp > 0) {
-    if (tex_) sprite_ = std::make_unique<sf::Sprite>(*tex_);
-    if (sprite_) {
-        sprite_->setPosition(position);
-        if (size.x > 0.f || size.y > 0.f) {
-            sf::Vector2u ts = tex_->getSize();
-            float scaleX = 1.f;
-            float scaleY = 1.f;
-            if (ts.x > 0 && size.x > 0.f) scaleX = size.x / static_cast<float>(ts.x);
-            if (ts.y > 0 && size.y > 0.f) scaleY = size.y / static_cast<float>(ts.y);
-            if (size.x > 0.f && size.y == 0.f && ts.y > 0) scaleY = scaleX;
-            if (size.y > 0.f && size.x == 0.f && ts.x > 0) scaleX = scaleY;
-            sprite_->setScale(sf::Vector2f{scaleX, scaleY});
+#include <bit>
+#include <cmath>
+
+// the classic bunker, in blocks; matches assets/textures/shield.png and is stretched over the box
+static const char* const BUNKER[] = {
+    "....#########....",
+    "...###########...",
+    "..#############..",
+    ".###############.",
+    "#################",
+    "#################",
+    "#################",
+    "#################",
+    "#################",
+    "#################",
+    "#################",
+    "#######...#######",
+    "######.....######",
+    "#####.......#####",
+    "####.........####",
+};
+static constexpr int BUNKER_COLS = 17;
+static constexpr int BUNKER_ROWS = static_cast<int>(sizeof(BUNKER) / sizeof(BUNKER[0]));
+
+Shield::Shield(const sf::Vector2f& position, const sf::Vector2f& size, float craterRadius)
+: position_(position), size_(size), craterRadius_(craterRadius) {
+    width_ = std::max(1, static_cast<int>(std::lround(size.x)));
+    height_ = std::max(1, static_cast<int>(std::lround(size.y)));
+    words_ = (width_ + 63) / 64;
+    mask_.assign(static_cast<size_t>(words_) * height_, 0);
+    for (int y = 0; y < height_; ++y) {
+        const char* blocks = BUNKER[y * BUNKER_ROWS / height_];
+        for (int x = 0; x < width_; ++x) {
+            if (blocks[x * BUNKER_COLS / width_] == '#') mask_[static_cast<size_t>(y) * words_ + (x >> 6)] |= std::uint64_t{1} << (x & 63);
         }
     }
+    for (std::uint64_t w : mask_) solid_ += std::popcount(w);
+    initial_ = solid_;
+    clearDirty();
 }
 
-void Shield::draw(sf::RenderWindow& window) const {
-    if (!active_) return;
-    if (sprite_) window.draw(*sprite_);
+sf::FloatRect Shield::bounds() const {
+    return sf::FloatRect{ position_, size_ };
 }
 
-sf::FloatRect Shield::bounds() const {
-    if (sprite_) return sprite_->getGlobalBounds();
-    return sf::FloatRect{};
+std::uint64_t Shield::spanBits(int x0, int x1, int w) {
+    const int lo = std::max(x0 - w * 64, 0);
+    const int hi = std::min(x1 - w * 64, 63);
+    if (lo > hi) return 0;
+    const std::uint64_t upTo = hi == 63 ? ~std::uint64_t{0} : (std::uint64_t{1} << (hi + 1)) - 1;
+    return upTo & ~((std::uint64_t{1} << lo) - 1);
 }
 
-bool Shield::takeDamage(int dmg) {
-    if (!active_) return false;
-    hp_ -= dmg;
-    if (hp_ <= 0) {
-        active_ = false;
-        return true;
+bool Shield::hitTest(const sf::FloatRect& box, bool movingDown, sf::Vector2i* impact) const {
+    if (solid_ == 0) return false;
+    // box -> inclusive mask pixel range, clipped to the mask
+    const int x0 = std::max(0, static_cast<int>(std::floor(box.position.x - position_.x)));
+    const int x1 = std::min(width_ - 1, static_cast<int>(std::ceil(box.position.x + box.size.x - position_.x)) - 1);
+    const int y0 = std::max(0, static_cast<int>(std::floor(box.position.y - position_.y)));
+    const int y1 = std::min(height_ - 1, static_cast<int>(std::ceil(box.position.y + box.size.y - position_.y)) - 1);
+    if (x0 > x1 || y0 > y1) return false;
+
+    const int w0 = x0 >> 6, w1 = x1 >> 6;
+    const int step = movingDown ? 1 : -1;
+    for (int y = movingDown ? y0 : y1; y >= y0 && y <= y1; y += step) {
+        const std::uint64_t* r = row(y);
+        for (int w = w0; w <= w1; ++w) {
+            const std::uint64_t hit = r[w] & spanBits(x0, x1, w);
+            if (!hit) continue;
+            if (impact) {
+                // centre of the box, pulled onto a solid pixel of this row if it sits in a gap
+                int cx = std::clamp(static_cast<int>(box.position.x + box.size.x * 0.5f - position_.x), x0, x1);
+                if (!solidAt(cx, y)) cx = w * 64 + std::countr_zero(hit);
+                *impact = { cx, y };
+            }
+            return true;
+        }
     }
-    float t = static_cast<float>(hp_) / static_cast<float>(std::max(1, maxHp_));
-    uint8_t alpha = static_cast<uint8_t>(std::max(64.0f, 255.0f * t));
-    if (sprite_) sprite_->setColor(sf::Color(255,255,255, alpha));
     return false;
 }
 
-bool Shield::isActive() const {
-    return active_;
-}
\ No newline at end of file
+int Shield::clearSpan(int y, int x0, int x1) {
+    x0 = std::max(x0, 0);
+    x1 = std::min(x1, width_ - 1);
+    if (y < 0 || y >= height_ || x0 > x1) return 0;
+    std::uint64_t* r = &mask_[static_cast<size_t>(y) * words_];
+    int removed = 0;
+    for (int w = x0 >> 6; w <= (x1 >> 6); ++w) {
+        const std::uint64_t cut = r[w] & spanBits(x0, x1, w);
+        removed += std::popcount(cut);
+        r[w] &= ~cut;
+    }
+    if (removed) {
+        dirtyBegin_ = std::min(dirtyBegin_, y);
+        dirtyEnd_ = std::max(dirtyEnd_, y + 1);
+    }
+    return removed;
+}
+
+int Shield::erode(const sf::Vector2i& center) {
+    const int r = std::max(1, static_cast<int>(craterRadius_));
+    int removed = 0;
+    for (int dy = -r; dy <= r; ++dy) {
+        const int half = static_cast<int>(std::sqrt(static_cast<float>(r * r - dy * dy)));
+        removed += clearSpan(center.y + dy, center.x - half, center.x + half);
+    }
+    solid_ -= removed;
+    return removed;
+}
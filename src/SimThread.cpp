@@ -0,0 +1,273 @@
+#include "SimThread.h"
+#include <iostream>
+#include <random>
+
+using Clock = std::chrono::steady_clock;
+
+SimThread::SimThread(const SimConfig& config, float step)
+: step_(step > 0.f ? step : 1.f / 120.f)
+, sim_(config) {
+}
+
+SimThread::~SimThread() {
+    stop();
+}
+
+void SimThread::playReplay(const Replay& replay, bool fastForward) {
+    replay_ = replay;
+    replaying_ = true;
+    fastForward_ = fastForward;
+}
+
+void SimThread::start() {
+    if (thread_.joinable()) return;
+    quit_.store(false, std::memory_order_relaxed);
+    thread_ = std::thread([this] { loop(); });
+}
+
+void SimThread::stop() {
+    if (!thread_.joinable()) return;
+    quit_.store(true, std::memory_order_release);
+    thread_.join();
+}
+
+void SimThread::reset() {
+    Command cmd;
+    cmd.kind = Command::Reset;
+    send(cmd);
+}
+
+void SimThread::setMode(Mode mode) {
+    Command cmd;
+    cmd.kind = Command::SetMode;
+    cmd.mode = mode;
+    send(cmd);
+}
+
+void SimThread::sendKey(const InputBuffer::KeyEvent& e) {
+    Command cmd;
+    cmd.kind = Command::Key;
+    cmd.key = e;
+    send(cmd);
+}
+
+void SimThread::setProfiling(bool on) {
+    Command cmd;
+    cmd.kind = Command::Profile;
+    cmd.profile = on;
+    send(cmd);
+}
+
+void SimThread::send(const Command& cmd) {
+    // the sim thread drains the queue at least once per millisecond, so a full queue clears fast
+    while (!commands_.push(cmd)) {
+        if (!thread_.joinable()) return;
+        std::this_thread::yield();
+    }
+}
+
+void SimThread::loop() {
+    const auto stepDuration = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(step_));
+    // a longer stall than this is dropped instead of replayed as a burst of catch-up ticks
+    const auto maxLag = std::chrono::milliseconds(250);
+    auto next = Clock::now();
+    auto lastPublish = next;
+
+    while (!quit_.load(std::memory_order_acquire)) {
+        drainCommands();
+        if (mode_ == Mode::Idle) {
+            inputs_.clearTaps(); // keep tracking held keys without piling up events
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            next = Clock::now();
+            continue;
+        }
+
+        if (replaying_ && fastForward_ && mode_ == Mode::Running && sim_.status() == SimStatus::Playing) {
+            // as fast as the CPU allows; snapshots go out about once per millisecond
+            tick(Clock::now());
+            const auto now = Clock::now();
+            if (now - lastPublish >= std::chrono::milliseconds(1) || !replaying_) { publish(); lastPublish = now; }
+            next = now;
+            continue;
+        }
+
+        const auto now = Clock::now();
+        if (now < next) {
+            // wake for the tick, then drain again so input sent meanwhile makes it in
+            std::this_thread::sleep_until(next);
+            continue;
+        }
+        if (now - next > maxLag) next = now;
+        // catch-up ticks keep their scheduled times, so each gets the input that was live then
+        tick(next);
+        publish();
+        next += stepDuration;
+    }
+    finishRecording();
+    reportLatency();
+    Profiler::setCurrent(nullptr);
+}
+
+void SimThread::drainCommands() {
+    Command cmd;
+    while (commands_.pop(cmd)) {
+        switch (cmd.kind) {
+        case Command::Key:
+            inputs_.push(cmd.key);
+            break;
+        case Command::Profile:
+            // the current profiler is per thread, so only this thread can switch its own
+            profiling_ = cmd.profile;
+            Profiler::setCurrent(profiling_ ? &profiler_ : nullptr);
+            break;
+        case Command::SetMode:
+            // leaving the game for the menus ends its recording, as quitting always has
+            if (cmd.mode == Mode::Idle) { finishRecording(); reportLatency(); }
+            mode_ = cmd.mode;
+            break;
+        case Command::Reset: {
+            finishRecording();
+            reportLatency();
+            // every game gets its own seed, so a recording only needs that game's inputs
+            const std::uint32_t seed = replaying_ ? replay_.seed() : static_cast<std::uint32_t>(std::random_device{}());
+            sim_.reset(seed);
+            ++game_;
+            tick_ = 0;
+            tickTime_ = Clock::now();
+            totals_ = SimEvents{};
+            inputs_.clearTaps();
+            replayTick_ = 0;
+            replayFinished_ = false;
+            if (replaying_) replayStart_ = tickTime_;
+            if (!recordPath_.empty() && !replaying_) {
+                recording_.begin(seed, step_);
+                isRecording_ = true;
+            }
+            mode_ = Mode::Running;
+            publish();
+            break;
+        }
+        }
+    }
+}
+
+void SimThread::tick(Clock::time_point scheduled) {
+    // consumed on every tick, paused or not, so a tap can't fire long after it happened
+    SimInput input = inputs_.consume(scheduled);
+    const std::optional<Clock::time_point> firePress = inputs_.firePress();
+    if (sim_.status() != SimStatus::Playing) return;
+    if (mode_ == Mode::Paused) {
+        // recorded so the tick count matches wall-clock play; playback just holds while paused
+        if (isRecording_) recording_.record(Replay::pack({}, true));
+        return;
+    }
+
+    if (replaying_) {
+        if (replayTick_ >= replay_.size()) { finishReplay(); return; }
+        const std::uint8_t bits = replay_.at(replayTick_++);
+        if (bits & Replay::Pause) return;
+        input = Replay::unpack(bits);
+    }
+    if (isRecording_) recording_.record(Replay::pack(input, false));
+
+    {
+        std::unique_lock<std::mutex> lock(profilerMutex_, std::defer_lock);
+        if (profiling_) { lock.lock(); profiler_.beginFrame(); }
+        sim_.step(input, step_);
+        if (profiling_) profiler_.endFrame();
+    }
+    ++tick_;
+    tickTime_ = Clock::now();
+    const SimEvents& events = sim_.events();
+    totals_.shotsFired += events.shotsFired;
+    totals_.enemiesKilled += events.enemiesKilled;
+    totals_.shieldHits += events.shieldHits;
+    totals_.playerHits += events.playerHits;
+    // press stamped by the event loop -> shot in the sim; measured live only, replays have no presses
+    if (events.shotsFired > 0 && firePress && !replaying_)
+        fireLatency_.add(std::chrono::duration<float, std::milli>(tickTime_ - *firePress).count());
+
+    if (sim_.status() != SimStatus::Playing) { finishRecording(); reportLatency(); }
+    if (replaying_ && replayTick_ >= replay_.size()) finishReplay();
+}
+
+void SimThread::finishRecording() {
+    if (!isRecording_) return;
+    isRecording_ = false;
+    if (recording_.size() == 0) return;
+    recording_.finish(sim_.checksum());
+    if (recording_.save(recordPath_)) std::cout << "[INFO] replay: saved " << recording_.size() << " ticks (seed " << recording_.seed() << ") to " << recordPath_ << "\n";
+    else std::cerr << "[WARN] could not write replay " << recordPath_ << "\n";
+}
+
+void SimThread::reportLatency() {
+    if (fireLatency_.count() == 0) return;
+    std::cout << "[INFO] input: fire-to-shot latency over " << fireLatency_.count() << " shots: avg "
+              << fireLatency_.meanMs() << " ms, p95 " << fireLatency_.percentileMs(0.95f) << " ms, max "
+              << fireLatency_.maxMs() << " ms\n";
+    fireLatency_.clear();
+}
+
+void SimThread::finishReplay() {
+    replaying_ = false;
+    fastForward_ = false;
+    replayFinished_ = true;
+    const float ms = std::chrono::duration<float, std::milli>(Clock::now() - replayStart_).count();
+    const bool match = sim_.checksum() == replay_.finalChecksum();
+    std::cout << "[INFO] replay: " << replayTick_ << " ticks in " << ms << " ms ("
+              << (ms > 0.f ? static_cast<float>(replayTick_) * 1000.f / ms : 0.f) << " ticks/s), "
+              << (match ? "final state matches the recording" : "DIVERGED from the recording") << "\n";
+}
+
+void SimThread::publish() {
+    RenderSnapshot& s = snapshots_.back();
+    s.game = game_;
+    s.tick = tick_;
+    s.tickTime = tickTime_;
+    s.paused = mode_ == Mode::Paused;
+    s.replayFinished = replayFinished_;
+    s.status = sim_.status();
+    s.score = sim_.score();
+    s.lives = sim_.lives();
+    s.shotsFired = totals_.shotsFired;
+    s.enemiesKilled = totals_.enemiesKilled;
+    s.playerHits = totals_.playerHits;
+    s.shieldHits = totals_.shieldHits;
+
+    const Formation& formation = sim_.formation();
+    s.formationOrigin = formation.origin();
+    s.formationMove = formation.lastMove();
+    s.enemies.clear();
+    for (const auto &e : formation.enemies()) {
+        if (!e.isActive()) continue;
+        if (e.isDiving()) s.enemies.push_back({ e.worldBounds(), e.prevPosition(), e.position(), e.kind(), true });
+        else s.enemies.push_back({ e.localBounds(), {}, {}, e.kind(), false });
+    }
+
+    const BulletPool& shots = sim_.bullets();
+    s.shots.clear();
+    for (int id : shots.active()) s.shots.push_back({ shots.bounds(id), shots.prevPosition(id), shots.position(id) });
+    const BulletPool& enemyShots = sim_.enemyBullets();
+    s.enemyShots.clear();
+    for (int id : enemyShots.active()) s.enemyShots.push_back({ enemyShots.bounds(id), enemyShots.prevPosition(id), enemyShots.position(id) });
+
+    const Player& player = sim_.player();
+    s.player = { player.bounds(), player.prevPosition(), player.position() };
+
+    const auto& shields = sim_.shields();
+    s.shields.resize(shields.size());
+    for (size_t i = 0; i < shields.size(); ++i) {
+        RenderSnapshot::ShieldView& v = s.shields[i];
+        const Shield& src = shields[i];
+        v.bounds = src.bounds();
+        v.width = src.width();
+        v.height = src.height();
+        v.wordsPerRow = src.wordsPerRow();
+        v.solidCount = src.solidCount();
+        const size_t words = static_cast<size_t>(src.height()) * src.wordsPerRow();
+        if (words == 0) v.mask.clear();
+        else v.mask.assign(src.row(0), src.row(0) + words);
+    }
+
+    snapshots_.publish();
+}
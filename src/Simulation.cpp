@@ -0,0 +1,350 @@
+#include "Simulation.h"
+#include "DivePath.h"
+#include "Profiler.h"
+#include "Sweep.h"
+#include <algorithm>
+#include <bit>
+
+Simulation::Simulation(const SimConfig& config, std::uint32_t seed)
+: config_(config)
+, bullets_(config.playerBulletPool, config.playerBulletSize)
+, enemyBullets_(config.enemyBulletPool, config.enemyBulletSize)
+, grid_(sf::FloatRect{ { 0.f, 0.f }, { config.fieldWidth(), config.fieldHeight() } }, static_cast<float>(config.cellSize) * 2.f)
+, rng_(seed)
+{
+    const float cell = static_cast<float>(config_.cellSize);
+    playerStart_ = sf::Vector2f(config_.margin.x + (config_.windowCols * cell) / 2.f,
+                                config_.margin.y + config_.hudHeight + (config_.windowRows * cell) - cell * 1.5f);
+
+    player_ = std::make_unique<Player>(playerStart_, config_.playerSize);
+    player_->setHorizontalLimits(16.f, config_.fieldWidth());
+    // bake the dive paths now rather than on the first dive (shared by every Simulation)
+    DivePath::library();
+
+    reset();
+}
+
+Simulation::~Simulation() = default;
+
+std::unique_ptr<Formation> Simulation::createFormation() const {
+    const float cell = static_cast<float>(config_.cellSize);
+    const float formationStartX = config_.margin.x + 2.f * cell;
+    const float formationStartY = config_.margin.y + config_.hudHeight + 1.f * cell;
+    const float spacingX = cell * 1.65f;
+    const float spacingY = cell * 1.15f;
+    auto formation = std::make_unique<Formation>(
+        config_.enemyCols, config_.enemyRows,
+        sf::Vector2f{ formationStartX, formationStartY },
+        spacingX, spacingY,
+        config_.enemySize,
+        40.f, 18.f
+    );
+    formation->setDiveExit(config_.fieldHeight());
+    return formation;
+}
+
+void Simulation::reset() {
+    player_->setPosition(playerStart_);
+    formation_ = createFormation();
+    bullets_.clear();
+    enemyBullets_.clear();
+    shields_.clear();
+    status_ = SimStatus::Playing;
+    events_ = SimEvents{};
+    score_ = 0;
+    lives_ = config_.startLives;
+
+    float shieldsY = player_->bounds().position.y - 120.f;
+    sf::Vector2f desiredSize = config_.shieldSize;
+    float padding = 48.f;
+    float available = config_.fieldWidth() - 2.f * padding;
+    float totalW = static_cast<float>(config_.shieldCount) * desiredSize.x;
+    float gapBetween = 0.f;
+    if (available > totalW && config_.shieldCount > 1) gapBetween = (available - totalW) / static_cast<float>(config_.shieldCount - 1) + desiredSize.x;
+    else gapBetween = desiredSize.x + 12.f;
+    float firstCenterX = padding + desiredSize.x * 0.5f;
+    for (int i = 0; i < config_.shieldCount; ++i) {
+        float centerX = firstCenterX + static_cast<float>(i) * gapBetween;
+        shields_.emplace_back(sf::Vector2f{ centerX - desiredSize.x / 2.f, shieldsY }, desiredSize, config_.shieldCraterRadius);
+    }
+
+    shootTimer_ = 0.f;
+    enemyShootTimer_ = enemyShootDist_(rng_);
+    diveTimer_ = diveDelayDist_(rng_);
+}
+
+void Simulation::reset(std::uint32_t seed) {
+    rng_.seed(seed);
+    enemyShootDist_.reset();
+    enemyColDist_.reset();
+    diveDelayDist_.reset();
+    divePathDist_.reset();
+    reset();
+}
+
+std::uint64_t Simulation::checksum() const {
+    std::uint64_t h = 14695981039346656037ull;
+    auto mix = [&h](std::uint64_t v) {
+        for (int i = 0; i < 8; ++i) { h ^= (v >> (8 * i)) & 0xFF; h *= 1099511628211ull; }
+    };
+    auto mixVec = [&mix](const sf::Vector2f& v) {
+        mix(std::bit_cast<std::uint32_t>(v.x));
+        mix(std::bit_cast<std::uint32_t>(v.y));
+    };
+    mix(static_cast<std::uint64_t>(score_));
+    mix(static_cast<std::uint64_t>(lives_));
+    mix(static_cast<std::uint64_t>(status_));
+    mixVec(player_->position());
+    mixVec(formation_->origin());
+    for (int i = 0; i < static_cast<int>(formation_->enemies().size()); ++i) mix(formation_->isAlive(i));
+    for (int i : formation_->divers()) mixVec(formation_->enemies()[i].position());
+    for (const BulletPool* pool : { &bullets_, &enemyBullets_ }) {
+        for (int id : pool->active()) mixVec(pool->position(id));
+    }
+    for (const auto &s : shields_) mix(static_cast<std::uint64_t>(s.solidCount()));
+    return h;
+}
+
+bool Simulation::trySpawnFromColumn(int col) {
+    if (!formation_) return false;
+    const int idx = formation_->lowestAlive(col);
+    if (idx < 0) return false;
+    sf::FloatRect eb = formation_->enemyBounds(idx);
+    sf::Vector2f shotPos{ eb.position.x + eb.size.x / 2.f, eb.position.y + eb.size.y + 4.f };
+    return enemyBullets_.spawn(shotPos, { 0.f, 220.f }) >= 0;
+}
+
+bool Simulation::rectsIntersect(const sf::FloatRect& a, const sf::FloatRect& b) {
+    return !(a.position.x + a.size.x < b.position.x ||
+             b.position.x + b.size.x < a.position.x ||
+             a.position.y + a.size.y < b.position.y ||
+             b.position.y + b.size.y < a.position.y);
+}
+
+void Simulation::rebuildBroadphase() {
+    // enemies are resolved by Formation::sweepTest on the lattice; the grid only holds shields
+    grid_.clear();
+    for (size_t i = 0; i < shields_.size(); ++i) {
+        if (shields_[i].isActive()) grid_.insert(static_cast<int>(i), shields_[i].bounds());
+    }
+}
+
+// time in [0, 1] at which a bullet sweeping from `start` by `move` reaches the shield pixel row
+// hitTest reported; bullets fly straight up or down, so only the leading edge's y matters
+static float shieldToi(const sf::FloatRect& start, const sf::Vector2f& move, const Shield& shield, const sf::Vector2i& impact) {
+    const float rowTop = shield.bounds().position.y + static_cast<float>(impact.y);
+    float t = 0.f;
+    if (move.y < 0.f) t = (start.position.y - (rowTop + 1.f)) / -move.y;
+    else if (move.y > 0.f) t = (rowTop - (start.position.y + start.size.y)) / move.y;
+    return std::clamp(t, 0.f, 1.f);
+}
+
+// Bullets are tested over the whole path they covered this step (prevPosition -> position), so
+// a long step or a fast bullet can't skip past a target between two positions.
+void Simulation::collidePlayerBullets() {
+    // retire() swaps the last live bullet into slot k, so only advance k on a miss
+    for (size_t k = 0; k < bullets_.activeCount();) {
+        int id = bullets_.active()[k];
+        const sf::FloatRect bb = bullets_.bounds(id);
+        const sf::Vector2f move = bullets_.position(id) - bullets_.prevPosition(id);
+        const sf::FloatRect start(bb.position - move, bb.size);
+        const sf::FloatRect swept = sweptBounds(start, move);
+        candidates_.clear();
+        collisionStats_.candidates += static_cast<int>(grid_.query(swept, candidates_));
+
+        // the bullet climbs, so hitTest over the swept column returns the first solid row it meets
+        int hitShield = -1;
+        float shieldT = 2.f;
+        sf::Vector2i impact;
+        for (int c : candidates_) {
+            sf::Vector2i at;
+            if (!shields_[c].hitTest(swept, false, &at)) continue;
+            const float t = shieldToi(start, move, shields_[c], at);
+            if (t < shieldT || (t == shieldT && c < hitShield)) { hitShield = c; shieldT = t; impact = at; }
+        }
+        // enemies moved too; sweepTest runs relative to the grid and to each diver
+        float enemyT = 2.f;
+        int hitEnemy = formation_->sweepTest(start, move, &enemyT, &collisionStats_.candidates);
+        // a shield hit at the same moment still blocks, as it always has
+        if (hitShield >= 0 && hitEnemy >= 0 && enemyT < shieldT) hitShield = -1;
+
+        if (hitShield >= 0) {
+            ++collisionStats_.hits;
+            shields_[hitShield].erode(impact);
+            ++events_.shieldHits;
+            bullets_.retire(id);
+        } else if (hitEnemy >= 0) {
+            ++collisionStats_.hits;
+            // a diver is worth double, as in the arcade
+            score_ += formation_->isDiving(hitEnemy) ? 20 : 10;
+            formation_->kill(hitEnemy);
+            ++events_.enemiesKilled;
+            bullets_.retire(id);
+        } else {
+            ++k;
+        }
+    }
+}
+
+void Simulation::collideEnemyBullets() {
+    for (size_t k = 0; k < enemyBullets_.activeCount();) {
+        int id = enemyBullets_.active()[k];
+        const sf::FloatRect bb = enemyBullets_.bounds(id);
+        const sf::Vector2f move = enemyBullets_.position(id) - enemyBullets_.prevPosition(id);
+        const sf::FloatRect start(bb.position - move, bb.size);
+        const sf::FloatRect swept = sweptBounds(start, move);
+        candidates_.clear();
+        collisionStats_.candidates += static_cast<int>(grid_.query(swept, candidates_));
+
+        int hitShield = -1;
+        float shieldT = 2.f;
+        sf::Vector2i impact;
+        for (int c : candidates_) {
+            sf::Vector2i at;
+            if (!shields_[c].hitTest(swept, true, &at)) continue;
+            const float t = shieldToi(start, move, shields_[c], at);
+            if (t < shieldT || (t == shieldT && c < hitShield)) { hitShield = c; shieldT = t; impact = at; }
+        }
+
+        // relative to the player, who may have moved sideways this step (re-read: a hit respawns them)
+        ++collisionStats_.candidates;
+        const sf::Vector2f playerMove = player_->position() - player_->prevPosition();
+        float playerT = 2.f;
+        const bool hitPlayer = sweepAabb(sf::FloatRect(start.position + playerMove, start.size), move - playerMove, player_->bounds(), playerT);
+
+        if (hitShield >= 0 && (!hitPlayer || shieldT <= playerT)) {
+            ++collisionStats_.hits;
+            shields_[hitShield].erode(impact);
+            ++events_.shieldHits;
+            enemyBullets_.retire(id);
+            continue;
+        }
+        if (hitPlayer) {
+            ++collisionStats_.hits;
+            enemyBullets_.retire(id);
+            damagePlayer();
+            continue;
+        }
+        ++k;
+    }
+}
+
+// a diver that reaches the ship destroys both; swept like the bullets, relative to the player
+void Simulation::collideDivers() {
+    const std::vector<int>& divers = formation_->divers();
+    // kill() swaps the last diver into slot k, so only advance k on a miss
+    for (size_t k = 0; k < divers.size() && status_ == SimStatus::Playing;) {
+        const int idx = divers[k];
+        const Enemy& e = formation_->enemies()[idx];
+        const sf::Vector2f move = e.position() - e.prevPosition();
+        const sf::FloatRect eb = e.worldBounds();
+        const sf::Vector2f playerMove = player_->position() - player_->prevPosition();
+        ++collisionStats_.candidates;
+        float t;
+        if (!sweepAabb(sf::FloatRect(eb.position - move + playerMove, eb.size), move - playerMove, player_->bounds(), t)) { ++k; continue; }
+        ++collisionStats_.hits;
+        formation_->kill(idx);
+        ++events_.enemiesKilled;
+        damagePlayer();
+    }
+}
+
+void Simulation::damagePlayer() {
+    lives_ -= 1;
+    ++events_.playerHits;
+    if (lives_ <= 0) {
+        status_ = SimStatus::Lost;
+    } else {
+        player_->setPosition(playerStart_);
+    }
+}
+
+// the lowest enemy of a random column peels off on a random path, swinging toward the near wall
+void Simulation::launchDive() {
+    const std::vector<int>& cols = formation_->liveColumns();
+    if (cols.empty() || static_cast<int>(formation_->divers().size()) >= config_.maxDivers) return;
+    using Range = std::uniform_int_distribution<int>::param_type;
+    const int idx = formation_->lowestAlive(cols[enemyColDist_(rng_, Range(0, static_cast<int>(cols.size()) - 1))]);
+    if (idx < 0 || formation_->isDiving(idx)) return;
+    const std::vector<DivePath>& paths = DivePath::library();
+    const DivePath& path = paths[divePathDist_(rng_, Range(0, static_cast<int>(paths.size()) - 1))];
+    const sf::FloatRect eb = formation_->enemyBounds(idx);
+    const bool mirror = eb.position.x + eb.size.x / 2.f > config_.fieldWidth() / 2.f;
+    formation_->startDive(idx, path, mirror, config_.diveSpeed);
+}
+
+void Simulation::step(const SimInput& input, float dt) {
+    events_ = SimEvents{};
+    collisionStats_ = CollisionStats{};
+    // dirty rows describe this step only; the front end re-uploads them after each step
+    for (auto &s : shields_) s.clearDirty();
+    if (status_ != SimStatus::Playing) return;
+
+    {
+        PROFILE_SCOPE("sim.input");
+        shootTimer_ -= dt; if (shootTimer_ < 0.f) shootTimer_ = 0.f;
+
+        if (input.left) player_->moveLeft(dt);
+        else if (input.right) player_->moveRight(dt);
+
+        if (input.fire && shootTimer_ <= 0.f) {
+            sf::FloatRect pb = player_->bounds();
+            sf::Vector2f bulletPos{ pb.position.x + pb.size.x / 2.f, pb.position.y - 6.f };
+            if (bullets_.spawn(bulletPos, { 0.f, -480.f }) >= 0) { ++events_.shotsFired; shootTimer_ = config_.shootCooldown; }
+        }
+    }
+
+    {
+        PROFILE_SCOPE("sim.movement");
+        player_->update(dt);
+        bullets_.update(dt);
+        enemyBullets_.update(dt);
+        formation_->update(dt, config_.margin.x, config_.fieldWidth() - config_.margin.x);
+    }
+
+    {
+        PROFILE_SCOPE("sim.enemyFire");
+        enemyShootTimer_ -= dt;
+        if (enemyShootTimer_ <= 0.f) {
+            // one pick among the columns that still have a shooter; no retries, any grid width
+            const std::vector<int>& cols = formation_->liveColumns();
+            if (!cols.empty()) {
+                using Range = std::uniform_int_distribution<int>::param_type;
+                trySpawnFromColumn(cols[enemyColDist_(rng_, Range(0, static_cast<int>(cols.size()) - 1))]);
+            }
+            enemyShootTimer_ = enemyShootDist_(rng_);
+        }
+    }
+
+    {
+        PROFILE_SCOPE("sim.dives");
+        diveTimer_ -= dt;
+        if (diveTimer_ <= 0.f) {
+            launchDive();
+            diveTimer_ = diveDelayDist_(rng_);
+        }
+    }
+
+    {
+        PROFILE_SCOPE("sim.broadphase");
+        rebuildBroadphase();
+    }
+    {
+        PROFILE_SCOPE("sim.collidePlayerBullets");
+        collidePlayerBullets();
+    }
+    {
+        PROFILE_SCOPE("sim.collideEnemyBullets");
+        collideEnemyBullets();
+    }
+    {
+        PROFILE_SCOPE("sim.collideDivers");
+        collideDivers();
+    }
+
+    PROFILE_SCOPE("sim.rules");
+    const float invasionY = playerStart_.y - static_cast<float>(config_.cellSize) * 0.5f;
+    if (formation_->aliveCount() > 0 && formation_->bottomY() >= invasionY) status_ = SimStatus::Lost;
+
+    if (status_ == SimStatus::Playing && formation_->aliveCount() == 0) status_ = SimStatus::Won;
+}
@@ -0,0 +1,58 @@
+#include "SpatialGrid.h"
+#include <algorithm>
+#include <cmath>
+
+SpatialGrid::SpatialGrid(const sf::FloatRect& area, float cellSize)
+: area_(area)
+{
+    if (cellSize <= 0.f) cellSize = 64.f;
+    invCell_ = 1.f / cellSize;
+    cols_ = std::max(1, static_cast<int>(std::ceil(area_.size.x * invCell_)));
+    rows_ = std::max(1, static_cast<int>(std::ceil(area_.size.y * invCell_)));
+    cells_.resize(static_cast<size_t>(cols_) * static_cast<size_t>(rows_));
+}
+
+SpatialGrid::CellRange SpatialGrid::cellRange(const sf::FloatRect& box) const {
+    auto toCol = [&](float x) { return std::clamp(static_cast<int>(std::floor((x - area_.position.x) * invCell_)), 0, cols_ - 1); };
+    auto toRow = [&](float y) { return std::clamp(static_cast<int>(std::floor((y - area_.position.y) * invCell_)), 0, rows_ - 1); };
+    return { toCol(box.position.x), toRow(box.position.y),
+             toCol(box.position.x + box.size.x), toRow(box.position.y + box.size.y) };
+}
+
+void SpatialGrid::clear() {
+    for (int cell : touched_) cells_[cell].clear();
+    touched_.clear();
+}
+
+void SpatialGrid::insert(int id, const sf::FloatRect& box) {
+    if (id < 0) return;
+    if (static_cast<size_t>(id) >= stamp_.size()) stamp_.resize(static_cast<size_t>(id) + 1, 0);
+    CellRange r = cellRange(box);
+    for (int row = r.r0; row <= r.r1; ++row) {
+        for (int col = r.c0; col <= r.c1; ++col) {
+            int cell = row * cols_ + col;
+            if (cells_[cell].empty()) touched_.push_back(cell);
+            cells_[cell].push_back(id);
+        }
+    }
+}
+
+size_t SpatialGrid::query(const sf::FloatRect& box, std::vector<int>& out) const {
+    if (++queryId_ == 0) {
+        // stamp wrapped around; forget every old mark
+        std::fill(stamp_.begin(), stamp_.end(), 0);
+        queryId_ = 1;
+    }
+    size_t before = out.size();
+    CellRange r = cellRange(box);
+    for (int row = r.r0; row <= r.r1; ++row) {
+        for (int col = r.c0; col <= r.c1; ++col) {
+            for (int id : cells_[row * cols_ + col]) {
+                if (stamp_[id] == queryId_) continue;
+                stamp_[id] = queryId_;
+                out.push_back(id);
+            }
+        }
+    }
+    return out.size() - before;
+}
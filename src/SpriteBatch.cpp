@@ -0,0 +1,48 @@
+#include "SpriteBatch.h"
+
+SpriteBatch::Layer& SpriteBatch::layerFor(const sf::Texture* tex) {
+    for (size_t i = 0; i < usedLayers_; ++i) {
+        if (layers_[i].texture == tex) return layers_[i];
+    }
+    if (usedLayers_ == layers_.size()) layers_.emplace_back();
+    Layer& layer = layers_[usedLayers_++];
+    layer.texture = tex;
+    return layer;
+}
+
+void SpriteBatch::add(const sf::Texture* tex, const sf::FloatRect& rect, sf::Color color) {
+    sf::Vector2f ts = tex ? sf::Vector2f(tex->getSize()) : sf::Vector2f{};
+    add(tex, rect, sf::FloatRect{ { 0.f, 0.f }, ts }, color);
+}
+
+void SpriteBatch::add(const sf::Texture* tex, const sf::FloatRect& rect, const sf::FloatRect& texRect, sf::Color color) {
+    sf::VertexArray& va = layerFor(tex).vertices;
+    const sf::Vector2f p0 = rect.position;
+    const sf::Vector2f p1 = rect.position + rect.size;
+    const sf::Vector2f t0 = texRect.position;
+    const sf::Vector2f t1 = texRect.position + texRect.size;
+
+    va.append({ p0, color, t0 });
+    va.append({ { p1.x, p0.y }, color, { t1.x, t0.y } });
+    va.append({ { p0.x, p1.y }, color, { t0.x, t1.y } });
+    va.append({ { p0.x, p1.y }, color, { t0.x, t1.y } });
+    va.append({ { p1.x, p0.y }, color, { t1.x, t0.y } });
+    va.append({ p1, color, t1 });
+}
+
+void SpriteBatch::flush(sf::RenderTarget& target, const sf::RenderStates& states) {
+    lastDrawCalls_ = 0;
+    lastQuadCount_ = 0;
+    for (size_t i = 0; i < usedLayers_; ++i) {
+        Layer& layer = layers_[i];
+        if (layer.vertices.getVertexCount() > 0) {
+            sf::RenderStates rs = states;
+            rs.texture = layer.texture;
+            target.draw(layer.vertices, rs);
+            ++lastDrawCalls_;
+            lastQuadCount_ += layer.vertices.getVertexCount() / 6;
+        }
+        layer.vertices.clear();
+    }
+    usedLayers_ = 0;
+}
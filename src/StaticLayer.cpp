@@ -0,0 +1,12 @@
+#include "StaticLayer.h"
+
+bool StaticLayer::create(sf::Vector2u size) {
+    valid_ = size.x > 0 && size.y > 0 && texture_.resize(size);
+    dirty_ = All;
+    return valid_;
+}
+
+sf::FloatRect StaticLayer::rect() const {
+    const sf::Vector2u size = texture_.getSize();
+    return sf::FloatRect({ 0.f, 0.f }, { static_cast<float>(size.x), static_cast<float>(size.y) });
+}
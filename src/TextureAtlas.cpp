@@ -0,0 +1,84 @@
+#include "TextureAtlas.h"
+#include <algorithm>
+#include <numeric>
+#include <iostream>
+
+// transparent gutter between packed images so neighbours never bleed into each other
+static constexpr unsigned int PADDING = 2;
+
+int TextureAtlas::add(sf::Image image) {
+    pending_.push_back(std::move(image));
+    regions_.emplace_back();
+    return static_cast<int>(regions_.size()) - 1;
+}
+
+bool TextureAtlas::build(unsigned int pageSize) {
+    pageSize = std::min(pageSize, sf::Texture::getMaximumSize());
+
+    std::vector<size_t> order(pending_.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return pending_[a].getSize().y > pending_[b].getSize().y;
+    });
+
+    struct Placement { size_t image; sf::Vector2u pos; };
+    struct Page { sf::Vector2u extent; std::vector<Placement> placed; };
+    std::vector<Page> pages;
+
+    // shelf cursor inside pages[current], the page being filled
+    int current = -1;
+    unsigned int shelfX = 0, shelfY = 0, shelfH = 0;
+    auto newPage = [&]() {
+        pages.push_back({});
+        current = static_cast<int>(pages.size()) - 1;
+        shelfX = shelfY = shelfH = 0;
+    };
+    for (size_t idx : order) {
+        sf::Vector2u sz = pending_[idx].getSize();
+        if (sz.x == 0 || sz.y == 0) continue;
+
+        if (sz.x > pageSize || sz.y > pageSize) {
+            // oversized: a dedicated page of exactly its own size
+            pages.push_back({ sz, { { idx, { 0, 0 } } } });
+            continue;
+        }
+        if (current < 0) newPage();
+        if (shelfX + sz.x > pageSize) { shelfY += shelfH + PADDING; shelfX = 0; shelfH = 0; }
+        if (shelfY + sz.y > pageSize) newPage();
+
+        Page& page = pages[current];
+        page.placed.push_back({ idx, { shelfX, shelfY } });
+        page.extent.x = std::max(page.extent.x, shelfX + sz.x);
+        page.extent.y = std::max(page.extent.y, shelfY + sz.y);
+        shelfX += sz.x + PADDING;
+        shelfH = std::max(shelfH, sz.y);
+    }
+
+    bool ok = true;
+    pages_.clear();
+    pages_.reserve(pages.size());
+    for (const Page& page : pages) {
+        if (page.placed.empty()) continue;
+        sf::Image canvas(page.extent, sf::Color::Transparent);
+        for (const Placement& p : page.placed) {
+            if (!canvas.copy(pending_[p.image], p.pos)) ok = false;
+        }
+
+        sf::Texture tex;
+        if (!tex.loadFromImage(canvas)) {
+            std::cerr << "[WARN] could not upload atlas page " << pages_.size() << "\n";
+            ok = false;
+            continue;
+        }
+        int pageIndex = static_cast<int>(pages_.size());
+        pages_.push_back(std::move(tex));
+        for (const Placement& p : page.placed) {
+            regions_[p.image].page = pageIndex;
+            regions_[p.image].rect = sf::FloatRect{ sf::Vector2f(p.pos), sf::Vector2f(pending_[p.image].getSize()) };
+        }
+    }
+
+    pending_.clear();
+    pending_.shrink_to_fit();
+    return ok;
+}
@@ -0,0 +1,64 @@
+#include "VoiceManager.h"
+
+VoiceManager::VoiceManager(size_t voiceCount)
+: voices_(voiceCount)
+{}
+
+int VoiceManager::addSound(sf::SoundBuffer buffer, int priority) {
+    sounds_.push_back(Sound{ std::make_unique<sf::SoundBuffer>(std::move(buffer)), priority });
+    pending_.reserve(sounds_.size());
+    return static_cast<int>(sounds_.size()) - 1;
+}
+
+void VoiceManager::play(int sound) {
+    if (sound < 0 || sound >= static_cast<int>(sounds_.size())) return;
+    if (sounds_[sound].pendingTriggers++ == 0) pending_.push_back(sound);
+}
+
+void VoiceManager::flush() {
+    ++frame_;
+    stats_ = Stats{};
+    for (int id : pending_) {
+        Sound &s = sounds_[id];
+        stats_.deduped += s.pendingTriggers - 1;
+        s.pendingTriggers = 0;
+
+        int v = pickVoice(id, s.priority);
+        if (v < 0) { ++stats_.dropped; continue; }
+        Voice &voice = voices_[v];
+        if (voice.sound && voice.sound->getStatus() == sf::SoundSource::Status::Playing) ++stats_.stolen;
+        if (!voice.sound) { voice.sound.emplace(*s.buffer); ++stats_.rebinds; }
+        else if (voice.soundId != id) { voice.sound->setBuffer(*s.buffer); ++stats_.rebinds; }
+        voice.soundId = id;
+        voice.priority = s.priority;
+        voice.startedAt = frame_;
+        voice.sound->play(); // restarts from the beginning if it was still playing
+        ++stats_.started;
+    }
+    pending_.clear();
+}
+
+int VoiceManager::pickVoice(int soundId, int priority) {
+    int freeVoice = -1;
+    int victim = -1;
+    for (int i = 0; i < static_cast<int>(voices_.size()); ++i) {
+        const Voice &v = voices_[i];
+        bool playing = v.sound && v.sound->getStatus() == sf::SoundSource::Status::Playing;
+        if (!playing) {
+            if (v.soundId == soundId) return i; // free and already bound: no rebind
+            if (freeVoice < 0) freeVoice = i;
+            continue;
+        }
+        if (v.startedAt == frame_) continue; // started this flush: never steal it back
+        if (v.priority > priority) continue;
+        if (victim < 0 || v.priority < voices_[victim].priority
+            || (v.priority == voices_[victim].priority && v.startedAt < voices_[victim].startedAt)) victim = i;
+    }
+    return freeVoice >= 0 ? freeVoice : victim;
+}
+
+size_t VoiceManager::activeVoices() const {
+    size_t n = 0;
+    for (const auto &v : voices_) if (v.sound && v.sound->getStatus() == sf::SoundSource::Status::Playing) ++n;
+    return n;
+}
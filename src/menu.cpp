@@ -10,9 +10,10 @@ Menu::Menu(const sf::Font* font, unsigned int charSize)
     pointer_.setPoint(0, sf::Vector2f(0.f, -12.f));
     pointer_.setPoint(1, sf::Vector2f(18.f, 0.f));
     pointer_.setPoint(2, sf::Vector2f(0.f, 12.f));
-    pointer_.setFillColor(sf::Color(200,200,200));
+    pointer_.setFillColor(colorSelected_);
     pointer_.setOutlineColor(sf::Color(80,80,80));
     pointer_.setOutlineThickness(-2.f);
+    fallbackBg_.setFillColor(sf::Color::Black);
 }
 
 void Menu::setOptions(const std::vector<std::string>& options, const sf::Vector2f& center, float spacing) {
@@ -45,6 +46,7 @@ void Menu::setBackground(const sf::Texture* tex) {
     } else {
         bgSprite_.reset();
     }
+    bgLaidOutFor_ = { 0, 0 }; // fuerza recalcular en el próximo draw
 }
 
 void Menu::processEvent(const sf::Event& ev, sf::RenderWindow& window) {
@@ -100,6 +102,22 @@ void Menu::update(float dt) {
 }
 
 void Menu::draw(sf::RenderWindow& window) const {
+    // el fondo solo se reescala cuando cambia el tamaño de la ventana
+    if (window.getSize() != bgLaidOutFor_) layoutBackground(window);
+    if (bgTex_ && bgSprite_) window.draw(*bgSprite_);
+    else window.draw(fallbackBg_);
+
+    // Draw items
+    for (size_t i = 0; i < items_.size(); ++i) {
+        if (!items_[i].getString().isEmpty()) window.draw(items_[i]);
+    }
+
+    // pointer_ ya está colocado por rebuild()
+    if (!items_.empty() && !items_[selected_].getString().isEmpty()) window.draw(pointer_);
+}
+
+void Menu::layoutBackground(const sf::RenderWindow& window) const {
+    bgLaidOutFor_ = window.getSize();
     // Draw background if present, scaled to window preserving aspect and centered
     if (bgTex_ && bgSprite_) {
         sf::Vector2u ts = bgTex_->getSize();
@@ -112,7 +130,6 @@ void Menu::draw(sf::RenderWindow& window) const {
             bgSprite_->setScale(sf::Vector2f(scale, scale));
             sf::FloatRect b = bgSprite_->getGlobalBounds();
             bgSprite_->setPosition(sf::Vector2f((ww - b.size.x) / 2.f, (wh - b.size.y) / 2.f));
-            window.draw(*bgSprite_);
         }
     } else {
         // dark background fallback
@@ -121,26 +138,8 @@ void Menu::draw(sf::RenderWindow& window) const {
         sf::Vector2i bottomRightPixel{ static_cast<int>(window.getSize().x), static_cast<int>(window.getSize().y) };
         sf::Vector2f topLeft = window.mapPixelToCoords(topLeftPixel);
         sf::Vector2f bottomRight = window.mapPixelToCoords(bottomRightPixel);
-        sf::RectangleShape rect(bottomRight - topLeft);
-        rect.setPosition(topLeft);
-        rect.setFillColor(sf::Color::Black);
-        window.draw(rect);
-    }
-
-    // Draw items
-    for (size_t i = 0; i < items_.size(); ++i) {
-        if (!items_[i].getString().isEmpty()) window.draw(items_[i]);
-    }
-
-    // Draw pointer triangle next to selected text
-    if (!items_.empty() && !items_[selected_].getString().isEmpty()) {
-        const sf::Text& t = items_[selected_];
-        sf::FloatRect tb = t.getGlobalBounds();
-        sf::Vector2f ppos(tb.position.x + pointerOffsetX_, tb.position.y + tb.size.y * 0.5f);
-        sf::ConvexShape ptr = pointer_;
-        ptr.setFillColor(colorSelected_);
-        ptr.setPosition(ppos);
-        window.draw(ptr);
+        fallbackBg_.setSize(bottomRight - topLeft);
+        fallbackBg_.setPosition(topLeft);
     }
 }
 
@@ -170,4 +169,8 @@ void Menu::rebuild() {
         t.setOrigin(sf::Vector2f(originX, originY));
         t.setPosition(sf::Vector2f(center_.x, startY + static_cast<float>(i) * spacing_));
     }
+
+    // pointer triangle next to selected text
+    sf::FloatRect tb = items_[selected_].getGlobalBounds();
+    pointer_.setPosition(sf::Vector2f(tb.position.x + pointerOffsetX_, tb.position.y + tb.size.y * 0.5f));
 }
\ No newline at end of file
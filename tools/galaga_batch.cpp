@@ -0,0 +1,95 @@
+// Runs many headless games at once through BatchRunner and reports aggregate throughput.
+//   galaga_batch [--games <n>] [--seconds <s>] [--threads <k>] [--seed <n>]
+// Without --threads it sweeps 1, 2, 4, ... up to the core count to show how it scales.
+#include "BatchRunner.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// cheap scripted player: sweeps toward a per-game target column, firing most of the time
+void botInputs(const BatchRunner& batch, std::vector<SimInput>& inputs, std::uint32_t tick) {
+    const float width = batch.simulation(0).config().fieldWidth();
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        std::uint32_t h = (static_cast<std::uint32_t>(i) * 2654435761u) ^ (tick / 90u * 40503u);
+        h ^= h >> 15;
+        const float target = static_cast<float>(h % 1000u) / 1000.f * width;
+        const float x = batch.observation(i).playerX;
+        inputs[i].left = x > target + 8.f;
+        inputs[i].right = x < target - 8.f;
+        inputs[i].fire = (h >> 10) % 4u != 0u;
+    }
+}
+
+struct RunResult {
+    double stepsPerSecond = 0.0;
+    int episodes = 0;
+    long long scoreSum = 0;
+};
+
+RunResult run(size_t games, unsigned threads, double seconds, std::uint32_t seed) {
+    BatchRunner batch(games, SimConfig{}, threads, seed);
+    std::vector<SimInput> inputs(games);
+    const float dt = 1.f / 120.f;
+    const int ticks = 4; // one decision per 4 sim steps, like a frame-skipping agent
+
+    std::uint32_t tick = 0;
+    const auto t0 = Clock::now();
+    while (std::chrono::duration<double>(Clock::now() - t0).count() < seconds) {
+        botInputs(batch, inputs, tick);
+        batch.step(inputs, dt, ticks);
+        tick += ticks;
+    }
+    const double elapsed = std::chrono::duration<double>(Clock::now() - t0).count();
+
+    RunResult r;
+    r.stepsPerSecond = static_cast<double>(batch.totalSteps()) / elapsed;
+    for (size_t i = 0; i < games; ++i) {
+        r.episodes += batch.observation(i).episodes;
+        r.scoreSum += batch.observation(i).score;
+    }
+    return r;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t games = 4096;
+    double seconds = 2.0;
+    unsigned threads = 0;
+    std::uint32_t seed = 1;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--games" && i + 1 < argc) games = static_cast<size_t>(std::stoul(argv[++i]));
+        else if (arg == "--seconds" && i + 1 < argc) seconds = std::stod(argv[++i]);
+        else if (arg == "--threads" && i + 1 < argc) threads = static_cast<unsigned>(std::stoul(argv[++i]));
+        else if (arg == "--seed" && i + 1 < argc) seed = static_cast<std::uint32_t>(std::stoul(argv[++i]));
+        else { std::cerr << "usage: galaga_batch [--games <n>] [--seconds <s>] [--threads <k>] [--seed <n>]\n"; return 2; }
+    }
+    if (games == 0) { std::cerr << "[ERROR] --games must be at least 1\n"; return 2; }
+
+    std::vector<unsigned> sweep;
+    if (threads > 0) sweep.push_back(threads);
+    else {
+        const unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+        for (unsigned t = 1; t < cores; t *= 2) sweep.push_back(t);
+        sweep.push_back(cores);
+    }
+
+    std::printf("%zu games, %.1f s per run\n", games, seconds);
+    std::printf("%8s %16s %9s %10s %12s\n", "threads", "steps/s", "speedup", "episodes", "score sum");
+    double base = 0.0;
+    for (unsigned t : sweep) {
+        const RunResult r = run(games, t, seconds, seed);
+        if (base == 0.0) base = r.stepsPerSecond;
+        std::printf("%8u %16.0f %8.2fx %10d %12lld\n", t, r.stepsPerSecond, r.stepsPerSecond / base, r.episodes, r.scoreSum);
+    }
+    return 0;
+}
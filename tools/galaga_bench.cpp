@@ -0,0 +1,209 @@
+// Micro-benchmarks for the simulation hot paths, at the stock grid and at synthetic scales.
+//   galaga_bench [--json <file>] [--min-ms <ms>]
+// Prints a table; --json also writes the results for comparing builds.
+#include "Simulation.h"
+#include "DivePath.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// reaches the private passes the game calls every step (friend of Formation and Simulation)
+struct BenchAccess {
+    static void computeBounds(Formation& f) { f.computeBounds(); }
+    static Formation& formation(Simulation& s) { return *s.formation_; }
+    static BulletPool& bullets(Simulation& s) { return s.bullets_; }
+    static BulletPool& enemyBullets(Simulation& s) { return s.enemyBullets_; }
+    static void rebuildBroadphase(Simulation& s) { s.rebuildBroadphase(); }
+    static void collidePlayerBullets(Simulation& s) { s.collidePlayerBullets(); }
+    static void collideEnemyBullets(Simulation& s) { s.collideEnemyBullets(); }
+    static bool trySpawnFromColumn(Simulation& s, int col) { return s.trySpawnFromColumn(col); }
+};
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Result {
+    std::string name;
+    std::string scale;
+    long long items = 0;      // entities (or calls) processed per op
+    long long iterations = 0;
+    double nsPerOp = 0.0;     // one timed body
+    double nsPerItem = 0.0;
+    double itemsPerSecond = 0.0;
+};
+
+struct Scale {
+    const char* name;
+    int cols;
+    int rows;
+    int bullets;
+};
+
+double minSeconds = 0.25;
+
+// setup() runs untimed before every timed body(); both see the same iteration index
+Result measure(const std::string& name, const Scale& scale, long long items,
+               const std::function<void()>& setup, const std::function<void()>& body) {
+    Result r{ name, scale.name, items };
+    Clock::duration timed{};
+    const auto wallStart = Clock::now();
+    while (timed < std::chrono::duration<double>(minSeconds) || r.iterations < 5) {
+        if (setup) setup();
+        const auto t0 = Clock::now();
+        body();
+        timed += Clock::now() - t0;
+        ++r.iterations;
+        if (Clock::now() - wallStart > std::chrono::seconds(20)) break;
+    }
+    r.nsPerOp = std::chrono::duration<double, std::nano>(timed).count() / static_cast<double>(r.iterations);
+    r.nsPerItem = items > 0 ? r.nsPerOp / static_cast<double>(items) : 0.0;
+    r.itemsPerSecond = r.nsPerOp > 0.0 ? static_cast<double>(items) * 1e9 / r.nsPerOp : 0.0;
+    return r;
+}
+
+// field large enough to hold the grid, so the formation marches instead of bouncing every step
+SimConfig configFor(const Scale& s) {
+    SimConfig c;
+    c.enemyCols = s.cols;
+    c.enemyRows = s.rows;
+    c.windowCols = std::max(c.windowCols, static_cast<int>(s.cols * 1.65f) + 8);
+    c.windowRows = std::max(c.windowRows, static_cast<int>(s.rows * 1.15f) + 12);
+    c.playerBulletPool = static_cast<size_t>(std::max(64, s.bullets));
+    c.enemyBulletPool = static_cast<size_t>(std::max(32, s.bullets));
+    return c;
+}
+
+// kills about half the grid (fixed seed) so column walks and bounds see holes
+void thinOut(Formation& f, std::mt19937& rng) {
+    for (int i = 0; i < static_cast<int>(f.enemies().size()); ++i) {
+        if (rng() & 1u) f.kill(i);
+    }
+}
+
+void scatter(BulletPool& pool, int count, const sf::FloatRect& area, const sf::Vector2f& vel, std::mt19937& rng) {
+    pool.clear();
+    std::uniform_real_distribution<float> x(area.position.x, area.position.x + area.size.x);
+    std::uniform_real_distribution<float> y(area.position.y, area.position.y + area.size.y);
+    for (int i = 0; i < count; ++i) pool.spawn({ x(rng), y(rng) }, vel);
+}
+
+void runScale(const Scale& scale, std::vector<Result>& out) {
+    const SimConfig config = configFor(scale);
+    const sf::FloatRect field({ 0.f, 0.f }, { config.fieldWidth(), config.fieldHeight() });
+    const long long enemies = static_cast<long long>(scale.cols) * scale.rows;
+    const float dt = 1.f / 120.f;
+    std::mt19937 rng(1234);
+
+    {
+        // fresh grid per op: each bounce speeds it up, so a reused one ends up bouncing every step
+        Simulation sim(config, 1);
+        const int steps = 1000;
+        out.push_back(measure("formation_update", scale, steps, [&] { sim.reset(1); }, [&] {
+            Formation& f = BenchAccess::formation(sim);
+            for (int i = 0; i < steps; ++i) f.update(dt, config.margin.x, config.fieldWidth() - config.margin.x);
+        }));
+    }
+    {
+        // every enemy out on a dive at once, one second of flight per op
+        Simulation sim(config, 1);
+        const std::vector<DivePath>& paths = DivePath::library();
+        const int steps = 120;
+        out.push_back(measure("dive_update", scale, enemies * steps, [&] {
+            sim.reset(1);
+            Formation& f = BenchAccess::formation(sim);
+            for (int i = 0; i < static_cast<int>(enemies); ++i) f.startDive(i, paths[i % paths.size()], i & 1, config.diveSpeed);
+        }, [&] {
+            Formation& f = BenchAccess::formation(sim);
+            for (int i = 0; i < steps; ++i) f.update(dt, config.margin.x, config.fieldWidth() - config.margin.x);
+        }));
+    }
+    {
+        Simulation sim(config, 1);
+        Formation& f = BenchAccess::formation(sim);
+        thinOut(f, rng);
+        out.push_back(measure("formation_compute_bounds", scale, enemies, nullptr, [&] { BenchAccess::computeBounds(f); }));
+    }
+    {
+        BulletPool pool(static_cast<size_t>(scale.bullets), config.playerBulletSize);
+        // slow bullets stay inside the keep-alive band for the whole run
+        scatter(pool, scale.bullets, field, { 0.f, -0.001f }, rng);
+        out.push_back(measure("bullet_update", scale, scale.bullets, nullptr, [&] { pool.update(dt); }));
+    }
+    {
+        // player shots spread over the formation and shield band; half the grid already dead
+        Simulation sim(config, 1);
+        const sf::FloatRect band({ 0.f, config.margin.y + config.hudHeight }, { field.size.x, field.size.y - config.hudHeight });
+        out.push_back(measure("collide_player_bullets", scale, scale.bullets, [&] {
+            sim.reset(1);
+            thinOut(BenchAccess::formation(sim), rng);
+            scatter(BenchAccess::bullets(sim), scale.bullets, band, { 0.f, -480.f }, rng);
+            BenchAccess::rebuildBroadphase(sim);
+        }, [&] { BenchAccess::collidePlayerBullets(sim); }));
+    }
+    {
+        Simulation sim(config, 1);
+        const sf::FloatRect band({ 0.f, field.size.y * 0.5f }, { field.size.x, field.size.y * 0.5f });
+        out.push_back(measure("collide_enemy_bullets", scale, scale.bullets, [&] {
+            sim.reset(1);
+            scatter(BenchAccess::enemyBullets(sim), scale.bullets, band, { 0.f, 220.f }, rng);
+            BenchAccess::rebuildBroadphase(sim);
+        }, [&] { BenchAccess::collideEnemyBullets(sim); }));
+    }
+    {
+        // one attempt per column; shots are cleared untimed so the pool never fills
+        Simulation sim(config, 1);
+        thinOut(BenchAccess::formation(sim), rng);
+        out.push_back(measure("try_spawn_from_column", scale, scale.cols, [&] { BenchAccess::enemyBullets(sim).clear(); }, [&] {
+            for (int c = 0; c < scale.cols; ++c) BenchAccess::trySpawnFromColumn(sim, c);
+        }));
+    }
+}
+
+void writeJson(const std::string& path, const std::vector<Result>& results) {
+    std::ofstream out(path);
+    out << "{\n  \"benchmarks\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        out << "    {\"name\": \"" << r.name << "\", \"scale\": \"" << r.scale << "\", \"items\": " << r.items
+            << ", \"iterations\": " << r.iterations << ", \"ns_per_op\": " << r.nsPerOp << ", \"ns_per_item\": " << r.nsPerItem
+            << ", \"items_per_second\": " << r.itemsPerSecond << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string jsonPath;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--json" && i + 1 < argc) jsonPath = argv[++i];
+        else if (arg == "--min-ms" && i + 1 < argc) minSeconds = std::stod(argv[++i]) / 1000.0;
+        else { std::cerr << "usage: galaga_bench [--json <file>] [--min-ms <ms>]\n"; return 2; }
+    }
+
+    // stock matches SimConfig defaults (11x5, 64 player shots); the rest stress the same code
+    const Scale scales[] = {
+        { "stock", 11, 5, 64 },
+        { "100x100_10k", 100, 100, 10000 },
+    };
+    std::vector<Result> results;
+    for (const auto &s : scales) runScale(s, results);
+
+    std::printf("%-26s %-12s %8s %14s %10s %12s\n", "benchmark", "scale", "items", "ns/op", "ns/item", "items/s");
+    for (const auto &r : results)
+        std::printf("%-26s %-12s %8lld %14.1f %10.2f %12.3e\n", r.name.c_str(), r.scale.c_str(), r.items, r.nsPerOp, r.nsPerItem, r.itemsPerSecond);
+
+    if (!jsonPath.empty()) {
+        writeJson(jsonPath, results);
+        std::cout << "wrote " << jsonPath << "\n";
+    }
+    return 0;
+}
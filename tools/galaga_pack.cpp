@@ -0,0 +1,29 @@
+// Builds assets.pak from an assets directory: galaga_pack <assets_dir> <out.pak>
+#include "AssetPack.h"
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        std::cerr << "usage: galaga_pack <assets_dir> <out.pak>\n";
+        return 2;
+    }
+    namespace fs = std::filesystem;
+    const fs::path root = argv[1];
+    if (!fs::is_directory(root)) {
+        std::cerr << "[ERROR] " << root.string() << " is not a directory\n";
+        return 1;
+    }
+
+    std::vector<std::pair<std::string, std::string>> files;
+    for (const auto& entry : fs::recursive_directory_iterator(root)) {
+        if (!entry.is_regular_file()) continue;
+        files.emplace_back(fs::relative(entry.path(), root).generic_string(), entry.path().string());
+    }
+    std::sort(files.begin(), files.end());
+
+    if (!AssetPack::write(argv[2], files)) return 1;
+    std::cout << "packed " << files.size() << " files into " << argv[2] << "\n";
+    return 0;
+}